@@ -0,0 +1,124 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "outstreams.hpp"
+#include "Arena.hpp"
+
+
+// most maps fit their objects in a few dozen of these,
+// an allocation bigger than a quarter block (like the
+// shortest path arrays on a big map) gets its own block
+// so the rest of the current block isn't wasted
+static const int ARENA_BLOCK_SIZE = 64*1024;
+
+// every allocation is rounded up to this, enough
+// for the doubles and 64-bit words in our structs
+static const int ARENA_ALIGN = 8;
+
+
+Arena::Arena()
+{
+  bytesAllocated = 0;
+  blocks         = NULL;
+  cleanups       = NULL;
+}
+
+
+Arena::~Arena()
+{
+  release();
+}
+
+
+// the block header is padded to the alignment too
+int Arena::headerBytes()
+{
+  return (sizeof( Block ) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+}
+
+
+void* Arena::alloc( int bytes )
+{
+  bytes = (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+  if( bytes > ARENA_BLOCK_SIZE / 4 )
+  {
+    // a big one gets a block to itself, slipped in behind the
+    // current block so the current one keeps filling up
+    Block* big = newBlock( bytes );
+    big->used = bytes;
+
+    if( blocks == NULL )
+    {
+      blocks = big;
+    } else {
+      big->next    = blocks->next;
+      blocks->next = big;
+    }
+
+    return (char*)big + headerBytes();
+  }
+
+  if( blocks == NULL || blocks->used + bytes > blocks->size )
+  {
+    Block* b = newBlock( ARENA_BLOCK_SIZE );
+    b->next  = blocks;
+    blocks   = b;
+  }
+
+  void* mem = (char*)blocks + headerBytes() + blocks->used;
+  blocks->used += bytes;
+
+  return mem;
+}
+
+
+void Arena::release()
+{
+  // destructors first, in the reverse order the
+  // objects were made, while the blocks are alive
+  while( cleanups != NULL )
+  {
+    cleanups->fn( cleanups->obj );
+    cleanups = cleanups->next;
+  }
+
+  while( blocks != NULL )
+  {
+    Block* next = blocks->next;
+    free( blocks );
+    blocks = next;
+  }
+
+  bytesAllocated = 0;
+}
+
+
+void Arena::addCleanup( void (*fn)( void* ), void* obj )
+{
+  // the cleanup records live in the arena as well
+  Cleanup* c = (Cleanup*)alloc( sizeof( Cleanup ) );
+  c->fn    = fn;
+  c->obj   = obj;
+  c->next  = cleanups;
+  cleanups = c;
+}
+
+
+Arena::Block* Arena::newBlock( int size )
+{
+  Block* b = (Block*)malloc( headerBytes() + size );
+  if( b == NULL )
+  {
+    printError( "Not enough system memory to continue.\n" );
+    exit( -1 );
+  }
+
+  b->next = NULL;
+  b->size = size;
+  b->used = 0;
+
+  bytesAllocated += headerBytes() + size;
+
+  return b;
+}
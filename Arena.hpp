@@ -0,0 +1,93 @@
+#ifndef ___Arena_hpp___
+#define ___Arena_hpp___
+
+#include <new>
+
+
+// a bump allocator that owns every analysis object for
+// one map.  Objects are carved out of big blocks one
+// after another and are never freed on their own, the
+// whole arena is released at once when the map is done,
+// which is a handful of block frees instead of a delete
+// for every node, resource, base...
+//
+// make() is for plain structs whose destructors have
+// nothing to do, their memory just goes away with the
+// blocks.  makeOwned() is for objects holding strings,
+// maps or lists, their destructors are remembered and
+// run when the arena is released.
+
+class Arena
+{
+public:
+
+  Arena();
+  ~Arena();
+
+  // raw memory, aligned for anything we store
+  void* alloc( int bytes );
+
+  template<typename T>
+  T* make()
+  {
+    return new( alloc( sizeof( T ) ) ) T();
+  }
+
+  template<typename T>
+  T* makeOwned()
+  {
+    T* obj = new( alloc( sizeof( T ) ) ) T();
+    addCleanup( &destroy<T>, obj );
+    return obj;
+  }
+
+  // uninitialized arrays of plain values
+  template<typename T>
+  T* makeArray( int n )
+  {
+    return (T*)alloc( n*sizeof( T ) );
+  }
+
+  // run the remembered destructors and free every
+  // block, the arena can be used again afterwards
+  void release();
+
+  int bytesAllocated;
+
+private:
+
+  struct Block
+  {
+    Block* next;
+    int    size;
+    int    used;
+  };
+
+  struct Cleanup
+  {
+    void   (*fn)( void* );
+    void*    obj;
+    Cleanup* next;
+  };
+
+  template<typename T>
+  static void destroy( void* obj )
+  {
+    ((T*)obj)->~T();
+  }
+
+  void addCleanup( void (*fn)( void* ), void* obj );
+
+  Block* newBlock( int size );
+  int    headerBytes();
+
+  Block*   blocks;
+  Cleanup* cleanups;
+
+  // arenas own their blocks, don't copy them around
+  Arena( const Arena& );
+  Arena& operator=( const Arena& );
+};
+
+
+#endif // ___Arena_hpp___
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "BitPlane.hpp"
+
+
+BitPlane::BitPlane()
+{
+  width       = 0;
+  height      = 0;
+  wordsPerRow = 0;
+  numWords    = 0;
+  words       = NULL;
+}
+
+
+BitPlane::~BitPlane()
+{
+  if( words )
+  {
+    delete[] words;
+  }
+}
+
+
+void BitPlane::resize( int widthIn, int heightIn )
+{
+  if( words )
+  {
+    delete[] words;
+  }
+
+  width       = widthIn;
+  height      = heightIn;
+  wordsPerRow = (width + 63) / 64;
+  numWords    = wordsPerRow * height;
+  words       = new u64[numWords];
+
+  clear();
+}
+
+
+void BitPlane::clear()
+{
+  memset( words, 0, numWords*sizeof( u64 ) );
+}
+
+
+void BitPlane::setAll()
+{
+  for( int y = 0; y < height; ++y )
+  {
+    if( width > 0 )
+    {
+      setSpan( y, 0, width - 1 );
+    }
+  }
+}
+
+
+void BitPlane::setSpan( int y, int x0, int x1 )
+{
+  u64* r = row( y );
+
+  int w0 = x0 >> 6;
+  int w1 = x1 >> 6;
+
+  u64 m0 = ~0ULL << (x0 & 63);
+  u64 m1 = ~0ULL >> (63 - (x1 & 63));
+
+  if( w0 == w1 )
+  {
+    r[w0] |= m0 & m1;
+    return;
+  }
+
+  r[w0] |= m0;
+  for( int w = w0 + 1; w < w1; ++w )
+  {
+    r[w] = ~0ULL;
+  }
+  r[w1] |= m1;
+}
+
+
+void BitPlane::copyFrom( BitPlane* other )
+{
+  memcpy( words, other->words, numWords*sizeof( u64 ) );
+}
+
+
+void BitPlane::andWith( BitPlane* other )
+{
+  for( int i = 0; i < numWords; ++i )
+  {
+    words[i] &= other->words[i];
+  }
+}
+
+
+void BitPlane::orWith( BitPlane* other )
+{
+  for( int i = 0; i < numWords; ++i )
+  {
+    words[i] |= other->words[i];
+  }
+}
+
+
+void BitPlane::andNotWith( BitPlane* other )
+{
+  for( int i = 0; i < numWords; ++i )
+  {
+    words[i] &= ~(other->words[i]);
+  }
+}
+
+
+int BitPlane::count()
+{
+  int n = 0;
+  for( int i = 0; i < numWords; ++i )
+  {
+    n += __builtin_popcountll( words[i] );
+  }
+  return n;
+}
+
+
+int BitPlane::countAnd( BitPlane* other )
+{
+  int n = 0;
+  for( int i = 0; i < numWords; ++i )
+  {
+    n += __builtin_popcountll( words[i] & other->words[i] );
+  }
+  return n;
+}
+
+
+void BitPlane::extractRow( int y, u64* out )
+{
+  memcpy( out, row( y ), wordsPerRow*sizeof( u64 ) );
+}
+
+
+int BitPlane::runEnd( int x, int y )
+{
+  u64* r = row( y );
+
+  // flip the row so the run we're in reads as zeros,
+  // then the first set bit at or after x ends the run
+  u64 flip = get( x, y ) ? ~0ULL : 0ULL;
+
+  int w    = x >> 6;
+  u64 diff = (r[w] ^ flip) & (~0ULL << (x & 63));
+
+  while( diff == 0 )
+  {
+    ++w;
+    if( w >= wordsPerRow )
+    {
+      return width;
+    }
+    diff = r[w] ^ flip;
+  }
+
+  int end = (w << 6) + __builtin_ctzll( diff );
+  if( end > width )
+  {
+    end = width;
+  }
+  return end;
+}
@@ -0,0 +1,89 @@
+#ifndef ___BitPlane_hpp___
+#define ___BitPlane_hpp___
+
+#include "sc2mapTypes.hpp"
+
+
+// a plane of one bit per cell, packed 64 cells to a
+// word where every row of cells starts on a fresh word,
+// so whole rows can be combined or counted a word at a
+// time instead of a cell at a time
+
+class BitPlane
+{
+public:
+
+  BitPlane();
+  ~BitPlane();
+
+  // resizing throws away the old contents and
+  // leaves every bit cleared
+  void resize( int widthIn, int heightIn );
+  void clear();
+
+  inline bool get( int x, int y )
+  {
+    return (words[y*wordsPerRow + (x >> 6)] >> (x & 63)) & 1ULL;
+  }
+
+  inline void set( int x, int y )
+  {
+    words[y*wordsPerRow + (x >> 6)] |= 1ULL << (x & 63);
+  }
+
+  inline void unset( int x, int y )
+  {
+    words[y*wordsPerRow + (x >> 6)] &= ~(1ULL << (x & 63));
+  }
+
+  inline bool inBounds( int x, int y )
+  {
+    return x >= 0 && x < width && y >= 0 && y < height;
+  }
+
+  // sets every bit inside the plane's width, the
+  // padding bits at the end of each row stay clear
+  void setAll();
+
+  // set bits x0 through x1, inclusive, in row y
+  void setSpan( int y, int x0, int x1 );
+
+  // whole-plane operations, the other plane must
+  // have the same dimensions
+  void copyFrom  ( BitPlane* other );
+  void andWith   ( BitPlane* other );
+  void orWith    ( BitPlane* other );
+  void andNotWith( BitPlane* other );
+
+  // number of set bits, alone or in common with
+  // another plane of the same dimensions
+  int count();
+  int countAnd( BitPlane* other );
+
+  // the words of one row, and a copy of them
+  inline u64* row( int y )
+  {
+    return words + y*wordsPerRow;
+  }
+  void extractRow( int y, u64* out );
+
+  // starting at x, the first x in row y whose bit differs
+  // from the bit at x, or the width if the run goes to
+  // the end of the row
+  int runEnd( int x, int y );
+
+  int  width;
+  int  height;
+  int  wordsPerRow;
+  int  numWords;
+  u64* words;
+
+private:
+
+  // planes own their words, don't copy them around
+  BitPlane( const BitPlane& );
+  BitPlane& operator=( const BitPlane& );
+};
+
+
+#endif // ___BitPlane_hpp___
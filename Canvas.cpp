@@ -0,0 +1,822 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "outstreams.hpp"
+#include "PngEncoder.hpp"
+#include "Canvas.hpp"
+
+
+
+void Stamp::clear( int wIn, int hIn )
+{
+  w     = wIn;
+  h     = hIn;
+  solid = false;
+  memset( rgb,  0, sizeof( rgb  ) );
+  memset( mask, 0, sizeof( mask ) );
+}
+
+
+void Stamp::set( int x, int y, Color* color )
+{
+  if( x < 0 || x >= w || y < 0 || y >= h )
+  {
+    printError( "Stamp pixel (%d, %d) is outside the %dx%d stamp.\n",
+                x, y, w, h );
+    exit( -1 );
+  }
+
+  int i = y*STAMP_MAX_DIM + x;
+  rgb[3*i + 0] = (u8)(color->r*255.0f + 0.5f);
+  rgb[3*i + 1] = (u8)(color->g*255.0f + 0.5f);
+  rgb[3*i + 2] = (u8)(color->b*255.0f + 0.5f);
+  mask[i] = 1;
+}
+
+
+void Stamp::fill( Color* color )
+{
+  for( int y = 0; y < h; ++y )
+  {
+    for( int x = 0; x < w; ++x )
+    {
+      set( x, y, color );
+    }
+  }
+  solid = true;
+}
+
+
+
+
+Layer::Layer()
+{
+  captured = false;
+}
+
+
+void Layer::clear()
+{
+  spans.clear();
+  rgb.clear();
+  captured = false;
+}
+
+
+void Layer::capture( Canvas* onBlack, Canvas* onWhite )
+{
+  if( onBlack->width  != onWhite->width ||
+      onBlack->height != onWhite->height )
+  {
+    printError( "Layer captured from canvases of different sizes.\n" );
+    exit( -1 );
+  }
+
+  clear();
+
+  for( int y = 1; y <= onBlack->height; ++y )
+  {
+    u8* b = onBlack->pixel( 1, y );
+    u8* w = onWhite->pixel( 1, y );
+
+    LayerSpan span;
+    span.len = 0;
+
+    for( int x = 1; x <= onBlack->width; ++x )
+    {
+      bool drawn = b[0] != 0x00 || b[1] != 0x00 || b[2] != 0x00 ||
+                   w[0] != 0xff || w[1] != 0xff || w[2] != 0xff;
+
+      if( drawn )
+      {
+        if( span.len == 0 )
+        {
+          span.x      = x - 1;
+          span.y      = y - 1;
+          span.offset = rgb.size();
+        }
+        ++span.len;
+
+        // a pixel drawn in black only shows up on white
+        u8* p = (b[0] | b[1] | b[2]) != 0 ? b : w;
+        rgb.push_back( p[0] );
+        rgb.push_back( p[1] );
+        rgb.push_back( p[2] );
+
+      } else if( span.len > 0 ) {
+        spans.push_back( span );
+        span.len = 0;
+      }
+
+      b += 3;
+      w += 3;
+    }
+
+    if( span.len > 0 )
+    {
+      spans.push_back( span );
+    }
+  }
+
+  captured = true;
+}
+
+
+
+
+Canvas::Canvas()
+{
+  width           = 0;
+  height          = 0;
+  pixels          = NULL;
+  pixelsAllocated = 0;
+
+  ftLibrary  = NULL;
+  ftFace     = NULL;
+  ftFaceSize = 0;
+}
+
+
+Canvas::~Canvas()
+{
+  if( ftFace != NULL )
+  {
+    FT_Done_Face( ftFace );
+  }
+  if( ftLibrary != NULL )
+  {
+    FT_Done_FreeType( ftLibrary );
+  }
+  free( pixels );
+}
+
+
+void Canvas::resize( int wIn, int hIn )
+{
+  width  = wIn;
+  height = hIn;
+
+  // keep the biggest buffer around, every image of
+  // a map is about the same size
+  int bytes = 3*width*height;
+  if( bytes > pixelsAllocated )
+  {
+    free( pixels );
+    pixels = (u8*)malloc( bytes );
+    if( pixels == NULL )
+    {
+      printError( "Could not allocate a %dx%d image.\n", width, height );
+      exit( -1 );
+    }
+    pixelsAllocated = bytes;
+  }
+
+  memset( pixels, 0, bytes );
+}
+
+
+void Canvas::fill( Color* color )
+{
+  if( width == 0 || height == 0 )
+  {
+    return;
+  }
+
+  filledSquare( 1, 1, width, height, color );
+}
+
+
+void Canvas::setFilename( const char* filenameIn )
+{
+  filename.assign( filenameIn );
+}
+
+
+void Canvas::toRGB8( Color* color, u8* rgb )
+{
+  float c[3] = { color->r, color->g, color->b };
+
+  for( int i = 0; i < 3; ++i )
+  {
+    if( c[i] < 0.0f ) { c[i] = 0.0f; }
+    if( c[i] > 1.0f ) { c[i] = 1.0f; }
+    rgb[i] = (u8)(c[i]*255.0f + 0.5f);
+  }
+}
+
+
+void Canvas::plot( int x, int y, Color* color )
+{
+  if( !inBounds( x, y ) )
+  {
+    return;
+  }
+  toRGB8( color, pixel( x, y ) );
+}
+
+
+// x0 and x1 are already clipped to the canvas
+void Canvas::fillSpan( int x0, int x1, int y, u8* rgb )
+{
+  u8* p = pixel( x0, y );
+  for( int x = x0; x <= x1; ++x )
+  {
+    p[0] = rgb[0];
+    p[1] = rgb[1];
+    p[2] = rgb[2];
+    p += 3;
+  }
+}
+
+
+// the rectangle is inclusive of both corners, fill
+// the first row and copy it up to the others
+void Canvas::filledSquare( int x0, int y0, int x1, int y1, Color* color )
+{
+  if( x0 > x1 ) { int t = x0; x0 = x1; x1 = t; }
+  if( y0 > y1 ) { int t = y0; y0 = y1; y1 = t; }
+
+  if( x0 < 1      ) { x0 = 1;      }
+  if( y0 < 1      ) { y0 = 1;      }
+  if( x1 > width  ) { x1 = width;  }
+  if( y1 > height ) { y1 = height; }
+
+  if( x0 > x1 || y0 > y1 )
+  {
+    return;
+  }
+
+  u8 rgb[3];
+  toRGB8( color, rgb );
+
+  fillSpan( x0, x1, y0, rgb );
+
+  u8* first = pixel( x0, y0 );
+  int bytes = 3*(x1 - x0 + 1);
+
+  for( int y = y0 + 1; y <= y1; ++y )
+  {
+    memcpy( pixel( x0, y ), first, bytes );
+  }
+}
+
+
+// copy len pixels onto row y starting at x0, whatever
+// falls off the canvas is dropped
+void Canvas::copyRow( int x0, int y, int len, const u8* rgb )
+{
+  if( y < 1 || y > height )
+  {
+    return;
+  }
+
+  int x1 = x0 + len - 1;
+  if( x0 < 1 )
+  {
+    rgb += 3*(1 - x0);
+    x0   = 1;
+  }
+  if( x1 > width )
+  {
+    x1 = width;
+  }
+
+  if( x0 > x1 )
+  {
+    return;
+  }
+
+  memcpy( pixel( x0, y ), rgb, 3*(x1 - x0 + 1) );
+}
+
+
+// Bresenham, both end points are plotted
+void Canvas::line( int x0, int y0, int x1, int y1, Color* color )
+{
+  u8 rgb[3];
+  toRGB8( color, rgb );
+
+  int dx =  abs( x1 - x0 );
+  int dy = -abs( y1 - y0 );
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int err = dx + dy;
+
+  while( true )
+  {
+    if( inBounds( x0, y0 ) )
+    {
+      u8* p = pixel( x0, y0 );
+      p[0] = rgb[0]; p[1] = rgb[1]; p[2] = rgb[2];
+    }
+
+    if( x0 == x1 && y0 == y1 )
+    {
+      break;
+    }
+
+    int e2 = 2*err;
+    if( e2 >= dy ) { err += dy; x0 += sx; }
+    if( e2 <= dx ) { err += dx; y0 += sy; }
+  }
+}
+
+
+// midpoint circle, just the outline
+void Canvas::circle( int xc, int yc, int radius, Color* color )
+{
+  int x = radius;
+  int y = 0;
+  int err = 1 - radius;
+
+  while( x >= y )
+  {
+    plot( xc + x, yc + y, color );
+    plot( xc + y, yc + x, color );
+    plot( xc - y, yc + x, color );
+    plot( xc - x, yc + y, color );
+    plot( xc - x, yc - y, color );
+    plot( xc - y, yc - x, color );
+    plot( xc + y, yc - x, color );
+    plot( xc + x, yc - y, color );
+
+    ++y;
+    if( err < 0 )
+    {
+      err += 2*y + 1;
+    } else {
+      --x;
+      err += 2*(y - x) + 1;
+    }
+  }
+}
+
+
+// a line with two short lines at the end point for
+// the head, each swung headAngle off the shaft
+void Canvas::arrow( int x0, int y0, int x1, int y1,
+                    int size, float headAngle, Color* color )
+{
+  line( x0, y0, x1, y1, color );
+
+  float dx  = (float)(x0 - x1);
+  float dy  = (float)(y0 - y1);
+  float len = sqrt( dx*dx + dy*dy );
+
+  if( len == 0.0f )
+  {
+    return;
+  }
+
+  float c = cos( headAngle );
+  float s = sin( headAngle );
+
+  float hx = (float)size*( dx*c - dy*s )/len;
+  float hy = (float)size*( dx*s + dy*c )/len;
+  line( x1, y1, x1 + (int)hx, y1 + (int)hy, color );
+
+  hx = (float)size*(  dx*c + dy*s )/len;
+  hy = (float)size*( -dx*s + dy*c )/len;
+  line( x1, y1, x1 + (int)hx, y1 + (int)hy, color );
+}
+
+
+// scanline fill between the long edge, from the lowest
+// to the highest point, and the two short edges
+void Canvas::filledTriangle( int x1, int y1,
+                             int x2, int y2,
+                             int x3, int y3,
+                             Color* color )
+{
+  // sort the points by ascending y
+  if( y2 < y1 ) { int t; t = x1; x1 = x2; x2 = t; t = y1; y1 = y2; y2 = t; }
+  if( y3 < y1 ) { int t; t = x1; x1 = x3; x3 = t; t = y1; y1 = y3; y3 = t; }
+  if( y3 < y2 ) { int t; t = x2; x2 = x3; x3 = t; t = y2; y2 = y3; y3 = t; }
+
+  u8 rgb[3];
+  toRGB8( color, rgb );
+
+  int yStart = y1 < 1      ? 1      : y1;
+  int yEnd   = y3 > height ? height : y3;
+
+  for( int y = yStart; y <= yEnd; ++y )
+  {
+    float xa;
+    if( y3 == y1 )
+    {
+      xa = (float)x1;
+    } else {
+      xa = (float)x1 + (float)((x3 - x1)*(y - y1)) / (float)(y3 - y1);
+    }
+
+    float xb;
+    if( y < y2 || (y == y2 && y2 == y3) )
+    {
+      if( y2 == y1 )
+      {
+        xb = (float)x2;
+      } else {
+        xb = (float)x1 + (float)((x2 - x1)*(y - y1)) / (float)(y2 - y1);
+      }
+    } else {
+      xb = (float)x2 + (float)((x3 - x2)*(y - y2)) / (float)(y3 - y2);
+    }
+
+    int xl = (int)floor( (xa < xb ? xa : xb) + 0.5f );
+    int xr = (int)floor( (xa < xb ? xb : xa) + 0.5f );
+
+    if( xl < 1     ) { xl = 1;     }
+    if( xr > width ) { xr = width; }
+
+    if( xl <= xr )
+    {
+      fillSpan( xl, xr, y, rgb );
+    }
+  }
+}
+
+
+void Canvas::blit( int x0, int y0, Stamp* stamp )
+{
+  // clip the stamp's columns once for every row
+  int i0 = x0 < 1 ? 1 - x0 : 0;
+  int i1 = stamp->w;
+  if( x0 + i1 - 1 > width )
+  {
+    i1 = width - x0 + 1;
+  }
+
+  if( i0 >= i1 )
+  {
+    return;
+  }
+
+  for( int j = 0; j < stamp->h; ++j )
+  {
+    int y = y0 + j;
+    if( y < 1 || y > height )
+    {
+      continue;
+    }
+
+    const u8* src = &(stamp->rgb[3*(j*STAMP_MAX_DIM + i0)]);
+    u8*       dst = pixel( x0 + i0, y );
+
+    if( stamp->solid )
+    {
+      memcpy( dst, src, 3*(i1 - i0) );
+      continue;
+    }
+
+    const u8* m = &(stamp->mask[j*STAMP_MAX_DIM + i0]);
+    for( int i = i0; i < i1; ++i )
+    {
+      if( *m )
+      {
+        dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+      }
+      ++m;
+      src += 3;
+      dst += 3;
+    }
+  }
+}
+
+
+void Canvas::paste( int x0, int y0, Layer* layer )
+{
+  for( int i = 0; i < (int)layer->spans.size(); ++i )
+  {
+    LayerSpan* span = &(layer->spans[i]);
+
+    int y = y0 + span->y + 1;
+    if( y < 1 || y > height )
+    {
+      continue;
+    }
+
+    int xStart = x0 + span->x + 1;
+    int xEnd   = xStart + span->len - 1;
+    int skip   = 0;
+
+    if( xStart < 1 )
+    {
+      skip   = 1 - xStart;
+      xStart = 1;
+    }
+    if( xEnd > width )
+    {
+      xEnd = width;
+    }
+    if( xStart > xEnd )
+    {
+      continue;
+    }
+
+    memcpy( pixel( xStart, y ),
+            &(layer->rgb[span->offset + 3*skip]),
+            3*(xEnd - xStart + 1) );
+  }
+}
+
+
+
+bool Canvas::loadFont( const char* fontface, int fontsize )
+{
+  if( ftLibrary == NULL )
+  {
+    if( FT_Init_FreeType( &ftLibrary ) != 0 )
+    {
+      ftLibrary = NULL;
+      return false;
+    }
+  }
+
+  if( ftFace == NULL || ftFaceName != fontface )
+  {
+    if( ftFace != NULL )
+    {
+      FT_Done_Face( ftFace );
+      ftFace = NULL;
+    }
+
+    if( FT_New_Face( ftLibrary, fontface, 0, &ftFace ) != 0 )
+    {
+      ftFace = NULL;
+      printWarning( "Could not load font %s.\n", fontface );
+      return false;
+    }
+
+    ftFaceName.assign( fontface );
+    ftFaceSize = 0;
+    glyphs.clear();
+  }
+
+  // sizes are in points at 100 dpi, same as pngwriter
+  if( ftFaceSize != fontsize )
+  {
+    FT_Set_Char_Size( ftFace, fontsize*64, fontsize*64, 100, 100 );
+    ftFaceSize = fontsize;
+  }
+
+  return true;
+}
+
+
+// render a glyph of the current face and size the first
+// time it's asked for, after that it comes from the cache
+Glyph* Canvas::getGlyph( FT_UInt index )
+{
+  pair<int, FT_UInt> key( ftFaceSize, index );
+
+  map< pair<int, FT_UInt>, Glyph >::iterator itr = glyphs.find( key );
+  if( itr != glyphs.end() )
+  {
+    return &(itr->second);
+  }
+
+  Glyph* g = &(glyphs[key]);
+  g->left    = 0;
+  g->top     = 0;
+  g->w       = 0;
+  g->h       = 0;
+  g->advance = 0;
+
+  FT_Set_Transform( ftFace, NULL, NULL );
+
+  if( FT_Load_Glyph( ftFace, index, FT_LOAD_RENDER ) != 0 )
+  {
+    // an empty glyph draws nothing and doesn't move the pen
+    return g;
+  }
+
+  FT_GlyphSlot slot = ftFace->glyph;
+  FT_Bitmap*   bm   = &(slot->bitmap);
+
+  g->left    = slot->bitmap_left;
+  g->top     = slot->bitmap_top;
+  g->w       = bm->width;
+  g->h       = bm->rows;
+  g->advance = slot->advance.x;
+
+  g->coverage.resize( g->w*g->h );
+  for( int j = 0; j < g->h; ++j )
+  {
+    for( int i = 0; i < g->w; ++i )
+    {
+      g->coverage[j*g->w + i] = bm->buffer[j*bm->pitch + i];
+    }
+  }
+
+  // plotting the glyph once at every offset in the radius
+  // leaves 1 - (1 - a1)(1 - a2)... of the outline color on
+  // a pixel, where a1, a2... are the coverages that land on
+  // it, and that is the same whatever is under the pixel
+  const int r  = TEXT_OUTLINE_RADIUS;
+  int       ow = g->w + 2*r;
+  int       oh = g->h + 2*r;
+
+  g->outline.resize( ow*oh );
+  for( int j = 0; j < oh; ++j )
+  {
+    for( int i = 0; i < ow; ++i )
+    {
+      float uncovered = 1.0f;
+
+      for( int dj = -r; dj <= r; ++dj )
+      {
+        int cj = j - r + dj;
+        if( cj < 0 || cj >= g->h ) { continue; }
+
+        for( int di = -r; di <= r; ++di )
+        {
+          int ci = i - r + di;
+          if( ci < 0 || ci >= g->w ) { continue; }
+
+          uncovered *= 1.0f - (float)g->coverage[cj*g->w + ci] / 255.0f;
+        }
+      }
+
+      g->outline[j*ow + i] = (u8)((1.0f - uncovered)*255.0f + 0.5f);
+    }
+  }
+
+  return g;
+}
+
+
+// blend the color into a w by h block of the canvas by
+// coverage, (x0, y0) is the top-left pixel of the block
+void Canvas::composite( int x0, int y0, int w, int h,
+                        const u8* coverage,
+                        Color* color )
+{
+  float c[3] = { color->r*255.0f, color->g*255.0f, color->b*255.0f };
+
+  for( int j = 0; j < h; ++j )
+  {
+    int py = y0 - j;
+    if( py < 1 || py > height )
+    {
+      continue;
+    }
+
+    for( int i = 0; i < w; ++i )
+    {
+      int px = x0 + i;
+
+      u8 a8 = coverage[j*w + i];
+      if( a8 == 0 || px < 1 || px > width )
+      {
+        continue;
+      }
+
+      float a = (float)a8 / 255.0f;
+      u8*   p = pixel( px, py );
+      for( int k = 0; k < 3; ++k )
+      {
+        p[k] = (u8)(a*c[k] + (1.0f - a)*(float)p[k] + 0.5f);
+      }
+    }
+  }
+}
+
+
+void Canvas::plotText( const char* fontface, int fontsize,
+                       int x, int y,
+                       const char* text,
+                       Color* color,
+                       Color* outline )
+{
+  if( !loadFont( fontface, fontsize ) )
+  {
+    return;
+  }
+
+  bool useKerning = FT_HAS_KERNING( ftFace );
+
+  // the whole outline goes down before any of the
+  // foreground so neighboring letters don't cover
+  // each other up
+  for( int pass = (outline == NULL ? 1 : 0); pass < 2; ++pass )
+  {
+    FT_UInt previous = 0;
+
+    // the pen is in 26.6 fixed point
+    int pen = x*64;
+
+    for( const char* ch = text; *ch != '\0'; ++ch )
+    {
+      FT_UInt index = FT_Get_Char_Index( ftFace, (u8)*ch );
+
+      if( useKerning && previous != 0 && index != 0 )
+      {
+        FT_Vector delta;
+        FT_Get_Kerning( ftFace, previous, index, FT_KERNING_DEFAULT, &delta );
+        pen += delta.x;
+      }
+
+      Glyph* g = getGlyph( index );
+
+      if( g->w == 0 || g->h == 0 )
+      {
+        pen += g->advance;
+        previous = index;
+        continue;
+      }
+
+      // the glyph rows go down from its top
+      // while the canvas rows go up
+      int x0 = (pen >> 6) + g->left + 1;
+      int y0 = y + g->top - 1;
+
+      if( pass == 0 )
+      {
+        const int r = TEXT_OUTLINE_RADIUS;
+        composite( x0 - r, y0 + r, g->w + 2*r, g->h + 2*r,
+                   &(g->outline[0]), outline );
+      } else {
+        composite( x0, y0, g->w, g->h,
+                   &(g->coverage[0]), color );
+      }
+
+      pen += g->advance;
+      previous = index;
+    }
+  }
+}
+
+
+int Canvas::getTextWidth( const char* fontface, int fontsize, const char* text )
+{
+  if( !loadFont( fontface, fontsize ) )
+  {
+    return 0;
+  }
+
+  bool    useKerning = FT_HAS_KERNING( ftFace );
+  FT_UInt previous   = 0;
+  int     w          = 0;
+
+  for( const char* ch = text; *ch != '\0'; ++ch )
+  {
+    FT_UInt index = FT_Get_Char_Index( ftFace, (u8)*ch );
+
+    if( useKerning && previous != 0 && index != 0 )
+    {
+      FT_Vector delta;
+      FT_Get_Kerning( ftFace, previous, index, FT_KERNING_DEFAULT, &delta );
+      w += delta.x >> 6;
+    }
+
+    w += getGlyph( index )->advance >> 6;
+    previous = index;
+  }
+
+  return w;
+}
+
+
+int Canvas::fontTest( const char* fontface )
+{
+  FT_Library library;
+  FT_Face    face;
+
+  int error = FT_Init_FreeType( &library );
+  if( error != 0 )
+  {
+    return error;
+  }
+
+  error = FT_New_Face( library, fontface, 0, &face );
+  if( error == 0 )
+  {
+    FT_Done_Face( face );
+  }
+
+  FT_Done_FreeType( library );
+  return error;
+}
+
+
+
+// hand the pixels to the encoder, the canvas gets a
+// fresh buffer when it's resized for the next image
+void Canvas::close( PngProfile* profile )
+{
+  PngImage* image = new PngImage();
+  image->pixels   = pixels;
+  image->width    = width;
+  image->height   = height;
+  image->filename = filename;
+  image->profile  = *profile;
+
+  pixels          = NULL;
+  pixelsAllocated = 0;
+  width           = 0;
+  height          = 0;
+
+  queuePng( image );
+}
@@ -0,0 +1,218 @@
+#ifndef ___Canvas_hpp___
+#define ___Canvas_hpp___
+
+#include <vector>
+#include <map>
+#include <string>
+using namespace std;
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "sc2mapTypes.hpp"
+
+
+// the biggest icon we pre-render is the 16x16 watchtower
+#define STAMP_MAX_DIM 16
+
+// text outlines reach this many pixels past the glyphs
+#define TEXT_OUTLINE_RADIUS 2
+
+
+// a small pre-rendered icon, like the terrain height marks
+// or a cell square, that gets copied onto the canvas whole
+// instead of plotting its pixels one by one.  Pixels with
+// a zero mask are left alone, a stamp with every pixel set
+// is solid and its rows are copied with memcpy.
+struct Stamp
+{
+  Stamp()
+  {
+    clear( 0, 0 );
+  }
+
+  void clear( int wIn, int hIn );
+  void set  ( int x, int y, Color* color );
+  void fill ( Color* color );
+
+  int  w;
+  int  h;
+  bool solid;
+
+  // rows go bottom to top just like the canvas
+  u8 rgb [STAMP_MAX_DIM*STAMP_MAX_DIM*3];
+  u8 mask[STAMP_MAX_DIM*STAMP_MAX_DIM];
+};
+
+
+class Canvas;
+struct PngProfile;
+
+
+// one rendered character of one font size.  The outline
+// is the coverage smeared over every offset within the
+// outline radius, exactly what plotting the glyph once per
+// offset would have covered, so an outlined label is two
+// composites per glyph instead of a full raster per offset
+struct Glyph
+{
+  // the top-left of the coverage relative to the pen
+  // on the baseline, rows go down from the top
+  int left;
+  int top;
+  int w;
+  int h;
+
+  // in 26.6 fixed point like the rest of FreeType
+  int advance;
+
+  vector<u8> coverage;
+
+  // TEXT_OUTLINE_RADIUS bigger on every side
+  vector<u8> outline;
+};
+
+
+// a run of pixels in a layer, its colors are
+// at offset in the layer's rgb array
+struct LayerSpan
+{
+  int x;
+  int y;
+  int len;
+  int offset;
+};
+
+
+// a picture that is drawn once and pasted over many
+// canvases, like the terrain marks that every image
+// shows.  Only the pixels that were actually drawn are
+// kept, in runs, so pasting leaves everything else alone.
+class Layer
+{
+public:
+
+  Layer();
+
+  // keep every pixel that was drawn on the two canvases,
+  // one cleared to black and the other to white before
+  // the same drawing went into both of them, so a pixel
+  // drawn in either background color is still caught
+  void capture( Canvas* onBlack, Canvas* onWhite );
+
+  void clear();
+
+  bool captured;
+
+  vector<LayerSpan> spans;
+  vector<u8>        rgb;
+};
+
+
+// an 8-bit RGB framebuffer the images are drawn into, the
+// PNG is only encoded once the whole image is done.
+//
+// Coordinates are the same as pngwriter's were, so the
+// image frame math didn't have to change: (1, 1) is the
+// bottom-left pixel and y goes up.  Anything drawn off the
+// edge of the canvas is clipped.
+class Canvas
+{
+public:
+
+  Canvas();
+  ~Canvas();
+
+  // resizing also colors every pixel black
+  void resize( int wIn, int hIn );
+  void fill( Color* color );
+  void setFilename( const char* filenameIn );
+
+  void plot        ( int x, int y, Color* color );
+  void filledSquare( int x0, int y0, int x1, int y1, Color* color );
+  void line        ( int x0, int y0, int x1, int y1, Color* color );
+  void circle      ( int xc, int yc, int radius, Color* color );
+  void arrow       ( int x0, int y0, int x1, int y1,
+                     int size, float headAngle, Color* color );
+  void filledTriangle( int x1, int y1,
+                       int x2, int y2,
+                       int x3, int y3,
+                       Color* color );
+
+  // copy a run of 8-bit RGB pixels onto row y from x0 on
+  void copyRow( int x0, int y, int len, const u8* rgb );
+
+  // put the stamp's bottom-left pixel at (x0, y0)
+  void blit( int x0, int y0, Stamp* stamp );
+
+  // the layer's pixel (x, y) lands on (x0 + x, y0 + y)
+  void paste( int x0, int y0, Layer* layer );
+
+  // text is anti-aliased against whatever is already
+  // on the canvas, (x, y) is the left end of the baseline,
+  // the outline goes down first if there is one
+  void plotText( const char* fontface, int fontsize,
+                 int x, int y,
+                 const char* text,
+                 Color* color,
+                 Color* outline );
+  int getTextWidth( const char* fontface, int fontsize, const char* text );
+
+  // queue the image to be written to the PNG file the
+  // way the profile says, the canvas is empty until it
+  // is resized again
+  void close( PngProfile* profile );
+
+  // returns non-zero if the font can't be loaded
+  static int fontTest( const char* fontface );
+
+  // the 8-bit pixel a color is drawn as
+  static void toRGB8( Color* color, u8* rgb );
+
+  int width;
+  int height;
+
+private:
+
+  friend class Layer;
+
+  inline u8* pixel( int x, int y )
+  {
+    return &(pixels[3*((y - 1)*width + (x - 1))]);
+  }
+
+  inline bool inBounds( int x, int y )
+  {
+    return x >= 1 && x <= width && y >= 1 && y <= height;
+  }
+
+  void fillSpan( int x0, int x1, int y, u8* rgb );
+
+  bool loadFont( const char* fontface, int fontsize );
+
+  Glyph* getGlyph( FT_UInt index );
+
+  void composite( int x0, int y0, int w, int h,
+                  const u8* coverage,
+                  Color* color );
+
+  u8*    pixels;
+  int    pixelsAllocated;
+  string filename;
+
+  FT_Library ftLibrary;
+  FT_Face    ftFace;
+  string     ftFaceName;
+  int        ftFaceSize;
+
+  // glyphs rendered so far with the current face,
+  // keyed by font size and glyph index
+  map< pair<int, FT_UInt>, Glyph > glyphs;
+
+  // canvases own their pixels, don't copy them around
+  Canvas( const Canvas& );
+  Canvas& operator=( const Canvas& );
+};
+
+
+#endif // ___Canvas_hpp___
@@ -0,0 +1,151 @@
+#ifndef ___Grid_hpp___
+#define ___Grid_hpp___
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "outstreams.hpp"
+
+
+// a two-dimensional layer of values for the map, one
+// value per cell (or terrain point, or whatever the
+// layer is indexed by) stored row by row.
+//
+// The grid can be padded with a border of extra cells
+// on every side that are filled like the rest of the
+// grid, so algorithms that look at neighbors can use
+// the unchecked accessors right up to the edges.
+//
+// get/set are checked and end the program on an out of
+// bounds access, at/row are unchecked fast paths for
+// loops that already know they are in bounds
+
+template<typename T>
+class Grid
+{
+public:
+
+  Grid()
+  {
+    width  = 0;
+    height = 0;
+    border = 0;
+    stride = 0;
+    data   = NULL;
+    cells  = NULL;
+  }
+
+  ~Grid()
+  {
+    if( data )
+    {
+      delete[] data;
+    }
+  }
+
+  // resizing throws away the old contents and
+  // fills every cell, border included, with v
+  void resize( int widthIn, int heightIn, int borderIn, T v )
+  {
+    if( data )
+    {
+      delete[] data;
+    }
+
+    width  = widthIn;
+    height = heightIn;
+    border = borderIn;
+    stride = width + 2*border;
+
+    data  = new T[stride*(height + 2*border)];
+    cells = data + border*stride + border;
+
+    fill( v );
+  }
+
+  void fill( T v )
+  {
+    int n = stride*(height + 2*border);
+    for( int i = 0; i < n; ++i )
+    {
+      data[i] = v;
+    }
+  }
+
+  // grids must have the same dimensions
+  void copyFrom( Grid<T>* other )
+  {
+    memcpy( data, other->data, stride*(height + 2*border)*sizeof( T ) );
+  }
+
+  inline bool isAllocated()
+  {
+    return data != NULL;
+  }
+
+  inline bool inBounds( int x, int y )
+  {
+    return x >= 0 && x < width && y >= 0 && y < height;
+  }
+
+
+  // checked access
+  T get( int x, int y )
+  {
+    check( x, y );
+    return at( x, y );
+  }
+
+  void set( int x, int y, T v )
+  {
+    check( x, y );
+    at( x, y ) = v;
+  }
+
+
+  // unchecked access, fine anywhere in the grid
+  // or its border
+  inline T& at( int x, int y )
+  {
+    return cells[y*stride + x];
+  }
+
+  // the first cell of a row, the rest of the row follows
+  // contiguously so loops can walk a row with a pointer
+  inline T* row( int y )
+  {
+    return cells + y*stride;
+  }
+
+
+  int width;
+  int height;
+  int border;
+  int stride;
+
+protected:
+
+  void check( int x, int y )
+  {
+    if( !inBounds( x, y ) )
+    {
+      printError( "Attempt to access grid cell (%d, %d) outside of %dx%d.\n",
+                  x, y, width, height );
+      exit( -1 );
+    }
+  }
+
+  // the whole allocation, and the
+  // first cell inside the border
+  T* data;
+  T* cells;
+
+private:
+
+  // grids own their cells, don't copy them around
+  Grid( const Grid<T>& );
+  Grid<T>& operator=( const Grid<T>& );
+};
+
+
+#endif // ___Grid_hpp___
@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "outstreams.hpp"
+#include "MapQueue.hpp"
+
+
+MapQueue::MapQueue( int capacityIn, int numProducersIn )
+{
+  capacity     = capacityIn     < 1 ? 1 : capacityIn;
+  numProducers = numProducersIn < 1 ? 1 : numProducersIn;
+
+  pthread_mutex_init( &lock,    NULL );
+  pthread_cond_init ( &changed, NULL );
+}
+
+
+MapQueue::~MapQueue()
+{
+  pthread_cond_destroy ( &changed );
+  pthread_mutex_destroy( &lock    );
+}
+
+
+void MapQueue::push( SC2Map* sc2map, int order )
+{
+  pthread_mutex_lock( &lock );
+
+  while( (int)maps.size() >= capacity )
+  {
+    pthread_cond_wait( &changed, &lock );
+  }
+
+  QueuedMap qm;
+  qm.sc2map = sc2map;
+  qm.order  = order;
+  maps.push_back( qm );
+
+  pthread_cond_broadcast( &changed );
+  pthread_mutex_unlock( &lock );
+}
+
+
+bool MapQueue::pop( QueuedMap* out )
+{
+  pthread_mutex_lock( &lock );
+
+  while( maps.empty() && numProducers > 0 )
+  {
+    pthread_cond_wait( &changed, &lock );
+  }
+
+  // nothing left and nobody left to push more
+  if( maps.empty() )
+  {
+    pthread_mutex_unlock( &lock );
+    return false;
+  }
+
+  *out = maps.front();
+  maps.pop_front();
+
+  pthread_cond_broadcast( &changed );
+  pthread_mutex_unlock( &lock );
+  return true;
+}
+
+
+void MapQueue::producerDone()
+{
+  pthread_mutex_lock( &lock );
+
+  --numProducers;
+
+  pthread_cond_broadcast( &changed );
+  pthread_mutex_unlock( &lock );
+}
@@ -0,0 +1,62 @@
+#ifndef ___MapQueue_hpp___
+#define ___MapQueue_hpp___
+
+#include <pthread.h>
+
+#include <list>
+using namespace std;
+
+
+class SC2Map;
+
+
+// a map on its way from one stage of the pipeline to
+// the next, order is where its file was found on the
+// to-analyze lists
+struct QueuedMap
+{
+  SC2Map* sc2map;
+  int     order;
+};
+
+
+// Maps are handed between the pipeline stages (reading,
+// analysis, rendering) through these.  A full queue
+// blocks whoever is pushing, so a fast stage can't pile
+// up whole maps in memory ahead of a slow one.  Every
+// worker of the stage before is a producer, and once
+// all of them are done and the queue is empty popping
+// tells the stage after to stop.
+class MapQueue
+{
+public:
+
+  MapQueue( int capacityIn, int numProducersIn );
+  ~MapQueue();
+
+  // blocks while the queue is full
+  void push( SC2Map* sc2map, int order );
+
+  // blocks while the queue is empty, returns false when
+  // there will never be another map
+  bool pop( QueuedMap* out );
+
+  // a producer won't push anything more
+  void producerDone();
+
+private:
+
+  list<QueuedMap> maps;
+  int             capacity;
+  int             numProducers;
+
+  pthread_mutex_t lock;
+  pthread_cond_t  changed;
+
+  // queues own their lock, don't copy them around
+  MapQueue( const MapQueue& );
+  MapQueue& operator=( const MapQueue& );
+};
+
+
+#endif // ___MapQueue_hpp___
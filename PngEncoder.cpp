@@ -0,0 +1,834 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <list>
+#include <vector>
+using namespace std;
+
+#include <pthread.h>
+#include <png.h>
+#include <zlib.h>
+
+#include "outstreams.hpp"
+#include "WorkerPool.hpp"
+#include "PngEncoder.hpp"
+
+
+
+// colors are looked up in a small open-addressed table,
+// twice as many slots as a palette can have colors
+static const int PALETTE_MAX   = 256;
+static const int PALETTE_SLOTS = 512;
+
+
+// try to give every pixel a palette index, false if the
+// image has too many colors for a palette.  Stops as soon
+// as there are too many so a full color image costs
+// little more than the pixels it takes to find out.
+static bool buildPalette( PngImage* image,
+                          png_color* palette,
+                          int*       numColors,
+                          u8*        indices )
+{
+  // slot keys are the color plus one so zero is empty
+  int keys [PALETTE_SLOTS];
+  u8  index[PALETTE_SLOTS];
+  memset( keys, 0, sizeof( keys ) );
+
+  *numColors = 0;
+
+  int lastKey   = 0;
+  u8  lastIndex = 0;
+
+  int numPixels = image->width*image->height;
+  u8* p         = image->pixels;
+
+  for( int i = 0; i < numPixels; ++i, p += 3 )
+  {
+    int key = ((p[0] << 16) | (p[1] << 8) | p[2]) + 1;
+
+    // the images are mostly long runs of one color
+    if( key == lastKey )
+    {
+      indices[i] = lastIndex;
+      continue;
+    }
+
+    int slot = (key * 2654435761u) >> 23;
+    while( keys[slot] != 0 && keys[slot] != key )
+    {
+      slot = (slot + 1) & (PALETTE_SLOTS - 1);
+    }
+
+    if( keys[slot] == 0 )
+    {
+      if( *numColors == PALETTE_MAX )
+      {
+        return false;
+      }
+
+      keys [slot] = key;
+      index[slot] = (u8)*numColors;
+
+      palette[*numColors].red   = p[0];
+      palette[*numColors].green = p[1];
+      palette[*numColors].blue  = p[2];
+      ++(*numColors);
+    }
+
+    lastKey   = key;
+    lastIndex = index[slot];
+    indices[i] = lastIndex;
+  }
+
+  return true;
+}
+
+
+// images with at least this many bytes of rows are split
+// into blocks that are deflated at the same time, smaller
+// ones aren't worth waking the workers for
+static const int PNG_PARALLEL_MIN_BYTES = 1024*1024;
+static const int PNG_BLOCK_MIN_BYTES    = 256*1024;
+
+// deflate looks back this far, so each block is primed
+// with this much of the rows before it
+static const int DEFLATE_WINDOW = 32*1024;
+
+
+// the filter type byte that leads every PNG row
+enum RowFilter
+{
+  ROWFILTER_NONE = 0,
+  ROWFILTER_SUB,
+  ROWFILTER_UP,
+  ROWFILTER_AVG,
+  ROWFILTER_PAETH,
+  NUM_ROWFILTERS
+};
+
+
+static inline int paeth( int a, int b, int c )
+{
+  int p  = a + b - c;
+  int pa = abs( p - a );
+  int pb = abs( p - b );
+  int pc = abs( p - c );
+
+  if( pa <= pb && pa <= pc )
+  {
+    return a;
+  }
+  if( pb <= pc )
+  {
+    return b;
+  }
+  return c;
+}
+
+
+// prev is the row above in the file, all zeros for the top
+// row.  The first pixel has nothing to its left so the
+// filters that look left treat it as zero.
+static void filterRow( int       type,
+                       const u8* row,
+                       const u8* prev,
+                       int       bpp,
+                       int       len,
+                       u8*       out )
+{
+  int i;
+
+  switch( type )
+  {
+    case ROWFILTER_NONE:
+      memcpy( out, row, len );
+    break;
+
+    case ROWFILTER_SUB:
+      for( i = 0; i < bpp; ++i )
+      {
+        out[i] = row[i];
+      }
+
+      for( i = bpp; i < len; ++i )
+      {
+        out[i] = (u8)(row[i] - row[i - bpp]);
+      }
+    break;
+
+    case ROWFILTER_UP:
+      for( i = 0; i < len; ++i )
+      {
+        out[i] = (u8)(row[i] - prev[i]);
+      }
+    break;
+
+    case ROWFILTER_AVG:
+      for( i = 0; i < bpp; ++i )
+      {
+        out[i] = (u8)(row[i] - (prev[i] >> 1));
+      }
+
+      for( i = bpp; i < len; ++i )
+      {
+        out[i] = (u8)(row[i] - ((row[i - bpp] + prev[i]) >> 1));
+      }
+    break;
+
+    case ROWFILTER_PAETH:
+      for( i = 0; i < bpp; ++i )
+      {
+        out[i] = (u8)(row[i] - prev[i]);
+      }
+
+      for( i = bpp; i < len; ++i )
+      {
+        out[i] = (u8)(row[i] - paeth( row[i - bpp], prev[i], prev[i - bpp] ));
+      }
+    break;
+  }
+}
+
+
+// the same guess libpng makes when it may pick the filter:
+// the one whose bytes, taken as signed, sum the smallest
+static int filterRowAdaptive( const u8* row,
+                              const u8* prev,
+                              int       bpp,
+                              int       len,
+                              u8*       out,
+                              u8*       scratch )
+{
+  int  bestType = ROWFILTER_NONE;
+  long bestSum  = -1;
+
+  for( int type = ROWFILTER_NONE; type < NUM_ROWFILTERS; ++type )
+  {
+    filterRow( type, row, prev, bpp, len, scratch );
+
+    long sum = 0;
+    for( int i = 0; i < len; ++i )
+    {
+      sum += scratch[i] < 128 ? scratch[i] : 256 - scratch[i];
+    }
+
+    if( bestSum < 0 || sum < bestSum )
+    {
+      bestSum  = sum;
+      bestType = type;
+      memcpy( out, scratch, len );
+    }
+  }
+
+  return bestType;
+}
+
+
+// the two bytes that start the zlib stream, the level
+// only goes in as a hint for whoever reads the file
+static void zlibHeader( int level, u8* header )
+{
+  int hint;
+  if( level < 2 ) {
+    hint = 0;
+  } else if( level < 6 ) {
+    hint = 1;
+  } else if( level < 7 ) {
+    hint = 2;
+  } else {
+    hint = 3;
+  }
+
+  header[0] = 0x78;
+  header[1] = (u8)(hint << 6);
+  header[1] += 31 - (header[0]*256 + header[1]) % 31;
+}
+
+
+// everything the block jobs share, the filtered rows are
+// one buffer in file order with each row led by its type
+struct PngBlocks
+{
+  PngImage*  image;
+  const u8*  rows;
+  int        bpp;
+  int        rowBytes;
+  int        numBlocks;
+  int        rowsPerBlock;
+  u8         header[2];
+
+  vector<u8> filtered;
+  vector<u8> zeroRow;
+
+  // one of each per block
+  vector< vector<u8> > deflated;
+  vector<uLong>        adlers;
+  vector<uLong>        crcs;
+
+  // a block that zlib choked on, the jobs run on the
+  // encoder's workers and must not exit from there,
+  // so encodePngBlocks looks at these afterwards
+  vector<u8>           failed;
+
+  const u8* fileRow( int i )
+  {
+    // PNG rows go top to bottom
+    return rows + (image->height - 1 - i)*rowBytes;
+  }
+
+  u8* filteredRow( int i )
+  {
+    return &(filtered[i*(1 + rowBytes)]);
+  }
+
+  int firstRow( int block )
+  {
+    return block*rowsPerBlock;
+  }
+
+  int endRow( int block )
+  {
+    int end = (block + 1)*rowsPerBlock;
+    return end < image->height ? end : image->height;
+  }
+};
+
+
+static void filterBlockJob( void* context, int block, int )
+{
+  PngBlocks* blocks = (PngBlocks*)context;
+
+  // same defaults as libpng, palette rows
+  // go unfiltered and RGB rows adaptive
+  int  type     = ROWFILTER_NONE;
+  bool adaptive = false;
+
+  switch( blocks->image->profile.filter )
+  {
+    case PNGFILTER_NONE:
+      type = ROWFILTER_NONE;
+    break;
+
+    case PNGFILTER_SUB:
+      type = ROWFILTER_SUB;
+    break;
+
+    case PNGFILTER_UP:
+      type = ROWFILTER_UP;
+    break;
+
+    case PNGFILTER_AVG:
+      type = ROWFILTER_AVG;
+    break;
+
+    case PNGFILTER_PAETH:
+      type = ROWFILTER_PAETH;
+    break;
+
+    case PNGFILTER_ALL:
+      adaptive = true;
+    break;
+
+    default:
+      adaptive = blocks->bpp > 1;
+    break;
+  }
+
+  vector<u8> scratch( blocks->rowBytes );
+
+  for( int i = blocks->firstRow( block ); i < blocks->endRow( block ); ++i )
+  {
+    const u8* row  = blocks->fileRow( i );
+    const u8* prev = i > 0 ? blocks->fileRow( i - 1 ) : &(blocks->zeroRow[0]);
+    u8*       out  = blocks->filteredRow( i );
+
+    if( adaptive )
+    {
+      out[0] = (u8)filterRowAdaptive( row, prev, blocks->bpp, blocks->rowBytes,
+                                      out + 1, &(scratch[0]) );
+    } else {
+      out[0] = (u8)type;
+      filterRow( type, row, prev, blocks->bpp, blocks->rowBytes, out + 1 );
+    }
+  }
+}
+
+
+static void deflateBlockJob( void* context, int block, int )
+{
+  PngBlocks* blocks = (PngBlocks*)context;
+  PngImage*  image  = blocks->image;
+
+  int  first = blocks->firstRow( block );
+  u8*  in    = blocks->filteredRow( first );
+  uInt inLen = (blocks->endRow( block ) - first)*(1 + blocks->rowBytes);
+
+  blocks->adlers[block] = adler32( adler32( 0L, Z_NULL, 0 ), in, inLen );
+
+  // raw deflate, the zlib header and trailer
+  // are written once for the whole image
+  z_stream z;
+  memset( &z, 0, sizeof( z ) );
+  if( deflateInit2( &z, image->profile.compressionLevel, Z_DEFLATED,
+                    -15, 8, Z_DEFAULT_STRATEGY ) != Z_OK )
+  {
+    blocks->failed[block] = 1;
+    return;
+  }
+
+  // let the block refer back to the rows before it like one
+  // long stream would, so splitting barely costs any size
+  int before = in - blocks->filteredRow( 0 );
+  if( before > 0 )
+  {
+    int dictLen = before < DEFLATE_WINDOW ? before : DEFLATE_WINDOW;
+    deflateSetDictionary( &z, in - dictLen, dictLen );
+  }
+
+  // blocks before the last end on a sync flush, which
+  // leaves the stream on a byte boundary without ending
+  // it, so the next block's bits can follow right on
+  bool lastBlock = block == blocks->numBlocks - 1;
+
+  vector<u8>* out = &(blocks->deflated[block]);
+  out->resize( deflateBound( &z, inLen ) + 64 );
+
+  z.next_in   = in;
+  z.avail_in  = inLen;
+  z.next_out  = &((*out)[0]);
+  z.avail_out = out->size();
+
+  while( true )
+  {
+    int ret = deflate( &z, lastBlock ? Z_FINISH : Z_SYNC_FLUSH );
+    if( ret == Z_STREAM_ERROR )
+    {
+      deflateEnd( &z );
+      blocks->failed[block] = 1;
+      return;
+    }
+
+    if( lastBlock ? ret == Z_STREAM_END : z.avail_out > 0 )
+    {
+      break;
+    }
+
+    // the bound should have been enough, but just in case
+    int used = out->size() - z.avail_out;
+    out->resize( out->size()*2 );
+    z.next_out  = &((*out)[used]);
+    z.avail_out = out->size() - used;
+  }
+
+  out->resize( z.total_out );
+  deflateEnd( &z );
+
+  // every block is an IDAT chunk of its own, the CRC of
+  // the last one gets the trailer added after the join
+  uLong crc = crc32( 0L, (const Bytef*)"IDAT", 4 );
+  if( block == 0 )
+  {
+    crc = crc32( crc, blocks->header, 2 );
+  }
+  crc = crc32( crc, &((*out)[0]), out->size() );
+  blocks->crcs[block] = crc;
+}
+
+
+static void writeU32( FILE* file, uLong x )
+{
+  u8 bytes[4];
+  bytes[0] = (u8)(x >> 24);
+  bytes[1] = (u8)(x >> 16);
+  bytes[2] = (u8)(x >>  8);
+  bytes[3] = (u8)(x      );
+  fwrite( bytes, 1, 4, file );
+}
+
+
+static void writeChunk( FILE* file, const char* type, const u8* data, int len )
+{
+  uLong crc = crc32( 0L, (const Bytef*)type, 4 );
+
+  writeU32( file, len );
+  fwrite( type, 1, 4, file );
+  if( len > 0 )
+  {
+    crc = crc32( crc, data, len );
+    fwrite( data, 1, len, file );
+  }
+  writeU32( file, crc );
+}
+
+
+// write a big image with its rows deflated in blocks by
+// the pool, the blocks are joined into one zlib stream so
+// the file is an ordinary PNG, false if a block failed
+static bool encodePngBlocks( PngImage*   image,
+                             FILE*       file,
+                             png_color*  palette,
+                             int         numColors,
+                             u8*         indices,
+                             int         numBlocks,
+                             WorkerPool* pool )
+{
+  PngBlocks blocks;
+  blocks.image        = image;
+  blocks.rows         = indices != NULL ? indices : image->pixels;
+  blocks.bpp          = indices != NULL ? 1 : 3;
+  blocks.rowBytes     = blocks.bpp*image->width;
+  blocks.rowsPerBlock = (image->height + numBlocks - 1) / numBlocks;
+  blocks.numBlocks    = (image->height + blocks.rowsPerBlock - 1) / blocks.rowsPerBlock;
+  zlibHeader( image->profile.compressionLevel, blocks.header );
+
+  blocks.filtered.resize( image->height*(1 + blocks.rowBytes) );
+  blocks.zeroRow .resize( blocks.rowBytes, 0 );
+  blocks.deflated.resize( blocks.numBlocks );
+  blocks.adlers  .resize( blocks.numBlocks );
+  blocks.crcs    .resize( blocks.numBlocks );
+  blocks.failed  .resize( blocks.numBlocks, 0 );
+
+  // every block has to be filtered before any is deflated
+  // because the blocks are primed with the rows before them
+  pool->run( blocks.numBlocks, &filterBlockJob,  &blocks );
+  pool->run( blocks.numBlocks, &deflateBlockJob, &blocks );
+
+  for( int b = 0; b < blocks.numBlocks; ++b )
+  {
+    if( blocks.failed[b] )
+    {
+      return false;
+    }
+  }
+
+  static const u8 signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  fwrite( signature, 1, 8, file );
+
+  u8 ihdr[13];
+  ihdr[0]  = (u8)(image->width  >> 24);
+  ihdr[1]  = (u8)(image->width  >> 16);
+  ihdr[2]  = (u8)(image->width  >>  8);
+  ihdr[3]  = (u8)(image->width       );
+  ihdr[4]  = (u8)(image->height >> 24);
+  ihdr[5]  = (u8)(image->height >> 16);
+  ihdr[6]  = (u8)(image->height >>  8);
+  ihdr[7]  = (u8)(image->height      );
+  ihdr[8]  = 8;
+  ihdr[9]  = indices != NULL ? PNG_COLOR_TYPE_PALETTE : PNG_COLOR_TYPE_RGB;
+  ihdr[10] = 0;
+  ihdr[11] = 0;
+  ihdr[12] = 0;
+  writeChunk( file, "IHDR", ihdr, 13 );
+
+  if( indices != NULL )
+  {
+    u8 plte[3*PALETTE_MAX];
+    for( int i = 0; i < numColors; ++i )
+    {
+      plte[3*i + 0] = palette[i].red;
+      plte[3*i + 1] = palette[i].green;
+      plte[3*i + 2] = palette[i].blue;
+    }
+    writeChunk( file, "PLTE", plte, 3*numColors );
+  }
+
+  // the zlib checksum is over all of the rows
+  uLong adler = blocks.adlers[0];
+  for( int b = 1; b < blocks.numBlocks; ++b )
+  {
+    int len = (blocks.endRow( b ) - blocks.firstRow( b ))*(1 + blocks.rowBytes);
+    adler = adler32_combine( adler, blocks.adlers[b], len );
+  }
+
+  u8 trailer[4];
+  trailer[0] = (u8)(adler >> 24);
+  trailer[1] = (u8)(adler >> 16);
+  trailer[2] = (u8)(adler >>  8);
+  trailer[3] = (u8)(adler      );
+
+  for( int b = 0; b < blocks.numBlocks; ++b )
+  {
+    vector<u8>* data = &(blocks.deflated[b]);
+
+    int   len = data->size();
+    uLong crc = blocks.crcs[b];
+
+    if( b == 0 )
+    {
+      len += 2;
+    }
+    if( b == blocks.numBlocks - 1 )
+    {
+      len += 4;
+      crc  = crc32( crc, trailer, 4 );
+    }
+
+    writeU32( file, len );
+    fwrite( "IDAT", 1, 4, file );
+    if( b == 0 )
+    {
+      fwrite( blocks.header, 1, 2, file );
+    }
+    fwrite( &((*data)[0]), 1, data->size(), file );
+    if( b == blocks.numBlocks - 1 )
+    {
+      fwrite( trailer, 1, 4, file );
+    }
+    writeU32( file, crc );
+  }
+
+  writeChunk( file, "IEND", NULL, 0 );
+  return true;
+}
+
+
+static int pngFilterFlags( PngFilter filter )
+{
+  switch( filter )
+  {
+    case PNGFILTER_NONE:  return PNG_FILTER_NONE;
+    case PNGFILTER_SUB:   return PNG_FILTER_SUB;
+    case PNGFILTER_UP:    return PNG_FILTER_UP;
+    case PNGFILTER_AVG:   return PNG_FILTER_AVG;
+    case PNGFILTER_PAETH: return PNG_FILTER_PAETH;
+    case PNGFILTER_ALL:   return PNG_ALL_FILTERS;
+    default:              return -1;
+  }
+}
+
+
+void encodePng( PngImage* image, WorkerPool* pool )
+{
+  PngProfile* profile = &(image->profile);
+
+  // decide on a palette before opening anything
+  png_color palette[PALETTE_MAX];
+  int       numColors = 0;
+  u8*       indices   = NULL;
+
+  if( profile->palette )
+  {
+    indices = (u8*)malloc( image->width*image->height );
+    if( indices == NULL )
+    {
+      printError( "Could not allocate palette indices for image %s.\n", image->filename.data() );
+      exit( -1 );
+    }
+
+    if( !buildPalette( image, palette, &numColors, indices ) )
+    {
+      free( indices );
+      indices = NULL;
+    }
+  }
+
+  FILE* file = fopen( image->filename.data(), "wb" );
+  if( file == NULL )
+  {
+    printWarning( "Could not open %s to write the image.\n", image->filename.data() );
+    free( indices );
+    return;
+  }
+
+  // big enough to be worth splitting up?
+  int bpp      = indices != NULL ? 1 : 3;
+  int rawBytes = image->height*(1 + bpp*image->width);
+
+  if( pool != NULL && pool->numWorkers > 1 && rawBytes >= PNG_PARALLEL_MIN_BYTES )
+  {
+    int numBlocks = rawBytes / PNG_BLOCK_MIN_BYTES;
+    if( numBlocks > pool->numWorkers )
+    {
+      numBlocks = pool->numWorkers;
+    }
+
+    bool ok = encodePngBlocks( image, file, palette, numColors, indices, numBlocks, pool );
+
+    fclose( file );
+    free( indices );
+
+    // back on the encoder thread, where exiting
+    // doesn't leave anyone waiting on the pool
+    if( !ok )
+    {
+      printError( "Failed to compress image %s.\n", image->filename.data() );
+      exit( -1 );
+    }
+    return;
+  }
+
+  png_structp png  = png_create_write_struct( PNG_LIBPNG_VER_STRING, NULL, NULL, NULL );
+  png_infop   info = png_create_info_struct( png );
+
+  if( png == NULL || info == NULL || setjmp( png_jmpbuf( png ) ) )
+  {
+    printError( "Failed to encode image %s.\n", image->filename.data() );
+    exit( -1 );
+  }
+
+  png_init_io( png, file );
+
+  png_set_compression_level( png, profile->compressionLevel );
+
+  int filterFlags = pngFilterFlags( profile->filter );
+  if( filterFlags >= 0 )
+  {
+    png_set_filter( png, PNG_FILTER_TYPE_BASE, filterFlags );
+  }
+
+  png_set_IHDR( png, info, image->width, image->height, 8,
+                indices != NULL ? PNG_COLOR_TYPE_PALETTE : PNG_COLOR_TYPE_RGB,
+                PNG_INTERLACE_NONE,
+                PNG_COMPRESSION_TYPE_DEFAULT,
+                PNG_FILTER_TYPE_DEFAULT );
+
+  if( indices != NULL )
+  {
+    png_set_PLTE( png, info, palette, numColors );
+  }
+
+  png_write_info( png, info );
+
+  // PNG rows go top to bottom
+  for( int y = image->height - 1; y >= 0; --y )
+  {
+    if( indices != NULL )
+    {
+      png_write_row( png, indices + y*image->width );
+    } else {
+      png_write_row( png, image->pixels + 3*y*image->width );
+    }
+  }
+
+  png_write_end( png, NULL );
+  png_destroy_write_struct( &png, &info );
+  fclose( file );
+
+  free( indices );
+}
+
+
+
+// how many bytes of pixels can wait in the queue, counting
+// the image being encoded, before queuing has to wait
+static const int PNG_QUEUE_MAX_BYTES = 64*1024*1024;
+
+static pthread_mutex_t queueLock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  queueChanged = PTHREAD_COND_INITIALIZER;
+
+static list<PngImage*> queue;
+static int             queueBytes      = 0;
+static bool            encoderRunning  = false;
+static bool            encoderStopping = false;
+static pthread_t       encoderThread;
+
+
+static int imageBytes( PngImage* image )
+{
+  return 3*image->width*image->height;
+}
+
+
+static void* encoderMain( void* )
+{
+  // the encoder's own workers for deflating big images
+  WorkerPool* pool = NULL;
+
+  pthread_mutex_lock( &queueLock );
+
+  while( true )
+  {
+    while( queue.empty() && !encoderStopping )
+    {
+      pthread_cond_wait( &queueChanged, &queueLock );
+    }
+
+    // only stop once everything has been written
+    if( queue.empty() )
+    {
+      break;
+    }
+
+    PngImage* image = queue.front();
+    queue.pop_front();
+
+    pthread_mutex_unlock( &queueLock );
+
+    int threads = image->profile.threads < 1 ? 1 : image->profile.threads;
+    if( pool == NULL || pool->numWorkers != threads )
+    {
+      delete pool;
+      pool = new WorkerPool( threads );
+    }
+
+    encodePng( image, pool );
+    pthread_mutex_lock( &queueLock );
+
+    queueBytes -= imageBytes( image );
+    delete image;
+
+    pthread_cond_broadcast( &queueChanged );
+  }
+
+  pthread_mutex_unlock( &queueLock );
+
+  delete pool;
+  return NULL;
+}
+
+
+void queuePng( PngImage* image )
+{
+  pthread_mutex_lock( &queueLock );
+
+  if( !encoderRunning )
+  {
+    if( pthread_create( &encoderThread, NULL, &encoderMain, NULL ) != 0 )
+    {
+      printError( "Could not start the image encoder thread.\n" );
+      exit( -1 );
+    }
+    encoderRunning = true;
+  }
+
+  // an image bigger than the whole budget
+  // still goes once the queue is empty
+  int bytes = imageBytes( image );
+  while( queueBytes > 0 && queueBytes + bytes > PNG_QUEUE_MAX_BYTES )
+  {
+    pthread_cond_wait( &queueChanged, &queueLock );
+  }
+
+  queue.push_back( image );
+  queueBytes += bytes;
+
+  pthread_cond_broadcast( &queueChanged );
+  pthread_mutex_unlock( &queueLock );
+}
+
+
+void flushPngQueue()
+{
+  pthread_mutex_lock( &queueLock );
+
+  // if the encoder itself is exiting there
+  // is nobody left to wait for
+  if( !encoderRunning || pthread_equal( pthread_self(), encoderThread ) )
+  {
+    pthread_mutex_unlock( &queueLock );
+    return;
+  }
+
+  encoderStopping = true;
+  pthread_cond_broadcast( &queueChanged );
+  pthread_mutex_unlock( &queueLock );
+
+  pthread_join( encoderThread, NULL );
+
+  pthread_mutex_lock( &queueLock );
+  encoderRunning  = false;
+  encoderStopping = false;
+  pthread_mutex_unlock( &queueLock );
+}
@@ -0,0 +1,96 @@
+#ifndef ___PngEncoder_hpp___
+#define ___PngEncoder_hpp___
+
+#include <stdlib.h>
+
+#include <string>
+using namespace std;
+
+#include "sc2mapTypes.hpp"
+
+
+// which PNG row filters the encoder may pick from,
+// all of them lets libpng choose per row which is
+// the smallest but the slowest
+enum PngFilter
+{
+  PNGFILTER_DEFAULT,
+  PNGFILTER_NONE,
+  PNGFILTER_SUB,
+  PNGFILTER_UP,
+  PNGFILTER_AVG,
+  PNGFILTER_PAETH,
+  PNGFILTER_ALL,
+};
+
+
+// how the images are written, set from output.txt
+struct PngProfile
+{
+  PngProfile()
+  {
+    compressionLevel = 6;
+    filter           = PNGFILTER_DEFAULT;
+    palette          = false;
+    threads          = 1;
+  }
+
+  // zlib level, 0 is no compression and 9 is the most
+  int       compressionLevel;
+  PngFilter filter;
+
+  // write an 8-bit indexed image whenever the image
+  // has 256 colors or less, otherwise it stays RGB
+  bool      palette;
+
+  // how many workers deflate a big image, this comes
+  // from the encodeThreads constant, not output.txt
+  int       threads;
+};
+
+
+// a finished image on its way to a PNG file, the
+// pixels are 8-bit RGB with the rows going bottom
+// to top, just like the canvas they came from
+struct PngImage
+{
+  PngImage()
+  {
+    pixels = NULL;
+    width  = 0;
+    height = 0;
+  }
+
+  ~PngImage()
+  {
+    free( pixels );
+  }
+
+  u8*        pixels;
+  int        width;
+  int        height;
+  string     filename;
+  PngProfile profile;
+};
+
+
+class WorkerPool;
+
+
+// encode and write the image right now, with a pool the
+// rows of a big image are deflated by all of its workers
+void encodePng( PngImage* image, WorkerPool* pool );
+
+
+// Images are encoded and written by a background thread
+// so the analysis doesn't wait on zlib.  The queue takes
+// the image and frees it once it is written.  If too many
+// bytes of images are already waiting, queuing blocks
+// until the encoder catches up.
+void queuePng( PngImage* image );
+
+// wait for every queued image to be written
+void flushPngQueue();
+
+
+#endif // ___PngEncoder_hpp___
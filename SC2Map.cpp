@@ -2,8 +2,6 @@
 #include <stdio.h>
 #include <assert.h>
 
-#include "pngwriter.h"
-
 #include "outstreams.hpp"
 #include "coordinates.hpp"
 #include "SC2Map.hpp"
@@ -11,7 +9,8 @@
 
 // Note that this set is static, there
 // is only one for the execution
-set<string> SC2Map::mapFilenamesUsed;
+set<string>     SC2Map::mapFilenamesUsed;
+pthread_mutex_t SC2Map::mapFilenamesLock = PTHREAD_MUTEX_INITIALIZER;
 
 
 
@@ -27,129 +26,57 @@ SC2Map::SC2Map( string toolPathIn,
   archiveName    = archiveNameIn;
   archiveWithExt = archiveWithExtIn;
 
-  mapHeight       = NULL;
-  mapCliffChanges = NULL;
-  mapPathing      = NULL;
-  mapOpenness     = NULL;
-  mapOpennessPrev = NULL;
-  mapPathNodes    = NULL;
-
-  totalMinerals     = 0.0f;
-  totalVespeneGas   = 0.0f;
-  totalHYMinerals   = 0.0f;
-  totalHYVespeneGas = 0.0f;
-
-  // the image parameters will be changed for each
-  // requested image to render
-  img = new pngwriter( 0, 0, 0.0, "dummy.png" );
-}
-
-
-SC2Map::~SC2Map()
-{
-  delete img;
-
-  for( list<Resource*>::const_iterator itr = resources.begin();
-       itr != resources.end();
-       ++itr )
-  {
-    delete *itr;
-  }
-
-  for( list<Base*>::const_iterator itr = bases.begin();
-       itr != bases.end();
-       ++itr )
-  {
-    Base* b = *itr;
-
-    for( list<StartLoc*>::const_iterator slItr = startLocs.begin();
-         slItr != startLocs.end();
-         ++slItr )
-    {
-      StartLoc* sl = *slItr;
-      delete b->sl1vsl2_influence[sl];
-    }
+  gradientsBaked = false;
+  stampsBaked    = false;
+  layersBaked    = false;
 
-    delete b;
-  }
+  influenceFieldsBaked = false;
 
-  for( list<StartLoc*>::const_iterator itr = startLocs.begin();
-       itr != startLocs.end();
-       ++itr )
-  {
-    delete *itr;
-  }
+  numStartLocs = 0;
+  numBases     = 0;
 
-  for( list<Watchtower*>::const_iterator itr = watchtowers.begin();
-       itr != watchtowers.end();
-       ++itr )
-  {
-    delete *itr;
-  }
+  sl2resourceInfluence          = NULL;
+  sl2opennessInfluence          = NULL;
+  sl2percentBalancedByResources = NULL;
+  sl2percentBalancedByOpenness  = NULL;
+  sl1vsl2_influence             = NULL;
+  sl2averageInfluence           = NULL;
 
-  for( list<Destruct*>::const_iterator itr = destructs.begin();
-       itr != destructs.end();
-       ++itr )
-  {
-    delete *itr;
-  }
+  watchtowerVisionCoverage = 0.0f;
+  mainPathVision           = 0.0f;
 
-  for( list<LoSB*>::const_iterator itr = losbs.begin();
-       itr != losbs.end();
-       ++itr )
-  {
-    delete *itr;
-  }
+  symmetry = SYMMETRY_NONE;
 
-  if( mapHeight )
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
   {
-    delete mapHeight;
+    symmetricGraph    [t] = false;
+    territoryContested[t] = 0.0f;
   }
 
-  if( mapCliffChanges )
-  {
-    delete mapCliffChanges;
-  }
+  totalMinerals     = 0.0f;
+  totalVespeneGas   = 0.0f;
+  totalHYMinerals   = 0.0f;
+  totalHYVespeneGas = 0.0f;
 
-  if( mapPathing )
-  {
-    delete mapPathing;
-  }
+  // the image parameters will be changed for each
+  // requested image to render, the render workers
+  // get canvases of their own when they start up
+  canvases.push_back( new Canvas() );
+  renderPool = NULL;
+}
 
-  if( mapOpenness )
-  {
-    delete mapOpenness;
-  }
 
-  if( mapOpennessPrev )
-  {
-    delete mapOpennessPrev;
-  }
+SC2Map::~SC2Map()
+{
+  delete renderPool;
 
-  if( mapPathNodes )
+  for( int i = 0; i < (int)canvases.size(); ++i )
   {
-    delete mapPathNodes;
+    delete canvases[i];
   }
 
-  for( int t = 0; t < NUM_PATH_TYPES; ++t )
-  {
-    for( int i = 0; i < nodes[t].size(); ++i )
-    {
-      delete nodes[t][i];
-    }
-
-    for( map< int, vector<float>* >::iterator itr = d[t].begin();
-         itr != d[t].end();
-         ++itr )
-    {
-      delete (*itr).second;
-    }
-
-    for( map< int, vector<Node*>* >::iterator itr = pi[t].begin();
-         itr != pi[t].end();
-         ++itr )
-    {
-      delete (*itr).second;
-    }
-  }
+  // the analysis objects are all in the arena, only
+  // the ones holding containers need a destructor
+  // call, everything else just goes with the blocks
+  arena.release();
 }
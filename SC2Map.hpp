@@ -10,12 +10,67 @@ using namespace std;
 
 #include "StormLib.h"
 #include "tinyxml.h"
-#include "pngwriter.h"
 
 #include "sc2mapTypes.hpp"
 #include "config.hpp"
 #include "coordinates.hpp"
 #include "PrioQueue.hpp"
+#include "BitPlane.hpp"
+#include "Grid.hpp"
+#include "Arena.hpp"
+#include "Canvas.hpp"
+#include "WorkerPool.hpp"
+
+
+// entries in each baked color gradient
+#define GRADIENT_LUT_SIZE 1024
+
+// openness is shaded with a different gradient
+// for low, middle and high ground
+enum OpennessLUT
+{
+  OPENNESS_LUT_LOW = 0,
+  OPENNESS_LUT_MID,
+  OPENNESS_LUT_HIGH,
+  NUM_OPENNESS_LUTS
+};
+
+
+// the images that are drawn over a layer of cells
+enum CellImageKind
+{
+  CELLIMAGE_TERRAIN,
+  CELLIMAGE_PATHING,
+  CELLIMAGE_BASES,
+  CELLIMAGE_OPENNESS,
+  CELLIMAGE_SUMMARY
+};
+
+// one of them while it's being drawn, t is the
+// pathing or openness its cells show
+struct CellImage
+{
+  CellImageKind kind;
+  PathType      t;
+  Canvas*       canvas;
+
+  // the frame the image was reset with
+  int iLeft;
+  int iBottom;
+  int iRight;
+  int iTop;
+};
+
+
+// a footprint found while reading placed objects,
+// applied once all of them are read
+struct FootToApply
+{
+  point  loc;
+  float  rot;
+  string type;
+  string name;
+};
 
 
 class SC2Map
@@ -38,6 +93,7 @@ public:
   //////////////////////////////////////////////////
   // implemented in config.cpp
   //////////////////////////////////////////////////
+  void   resolveConfig();
   int    getiConstant   ( string name );
   float  getfConstant   ( string name );
   Color* getColor       ( string name );
@@ -56,6 +112,12 @@ public:
   void countPathableCells();
 
 
+  //////////////////////////////////////////////////
+  // implemented in components.cpp
+  //////////////////////////////////////////////////
+  void labelComponents();
+
+
   //////////////////////////////////////////////////
   // implemented in placedobjects.cpp
   //////////////////////////////////////////////////
@@ -75,6 +137,51 @@ public:
   //////////////////////////////////////////////////
   void computeOpenness();
   void locateChokes();
+
+
+  //////////////////////////////////////////////////
+  // implemented in vision.cpp
+  //////////////////////////////////////////////////
+  void analyzeVision();
+
+  // accumulate into the plane every cell visible from
+  // a point, respecting high ground and LoS blockers
+  void computeVision( point* p, float range, BitPlane* visible );
+
+
+  //////////////////////////////////////////////////
+  // implemented in symmetry.cpp
+  //////////////////////////////////////////////////
+  void detectSymmetry();
+
+  const char* getSymmetryName();
+
+  // the symmetry found for the map, and for each path
+  // type whether the pathing matches its image cell for
+  // cell, because only then can one start location's
+  // shortest paths be transformed into its partner's
+  SymmetryType symmetry;
+  bool         symmetricGraph[NUM_PATH_TYPES];
+
+
+  //////////////////////////////////////////////////
+  // implemented in territory.cpp
+  //////////////////////////////////////////////////
+  void computeTerritories();
+
+  // per cell, the start locations nearest to it by
+  // ground and by cliff-walk with rocks
+  Grid<Territory> mapTerritory[NUM_PATH_TYPES];
+
+  // cells where the nearest two start locations are
+  // within the contested margin of each other
+  BitPlane contestedTerritory[NUM_PATH_TYPES];
+
+  // per start location index, the fraction of reachable
+  // cells it is nearest to, and the fraction of
+  // reachable cells that are contested
+  vector<float> territoryShare[NUM_PATH_TYPES];
+  float         territoryContested[NUM_PATH_TYPES];
   
 
   //////////////////////////////////////////////////
@@ -95,13 +202,17 @@ public:
 
   // do at program entry to verify beforehand the
   // PNG writing will work
-  static int pngwriterTest();
-
-  // one image
-  void renderImageSummary();
-
-  // one image, uses path type="ground with rocks"
-  void renderImageOpenness();
+  static int fontTest();
+
+  // one image each for the terrain, the bases, the
+  // openness and the summary, and one per pathing type,
+  // whichever are asked for are drawn together so the
+  // cells under them are walked only once
+  void renderCellImages( bool terrain,
+                         bool pathing,
+                         bool bases,
+                         bool openness,
+                         bool summary );
 
   // two images for each start location pair,
   // one for paths between mains, one between nats
@@ -113,15 +224,6 @@ public:
   // one image per pair of start locations
   void renderImagesInfluenceHeatMap();
 
-  // one image, just terrain layer
-  void renderImageTerrainOnly();
-
-  // one image for each pathing type
-  void renderImagesPathing();
-
-  // one image, all bases with labels
-  void renderImageBases();
-
   // for development
   void renderTestImages();
 
@@ -146,6 +248,15 @@ public:
 
   Config configUserLocal;
 
+  // filled in by resolveConfig(), the hot loops
+  // read constants and colors from here
+  ResolvedConfig rc;
+
+  // every node, resource, base, start location and
+  // so on for this map lives in here, and all of it
+  // goes away at once when the map is deleted
+  Arena arena;
+
 
 
   //////////////////////////////////////////////////
@@ -174,8 +285,15 @@ public:
 
   void makeMapNameValidForFilenames();
 
-  // when opening several maps, warn when a map filename is reused
-  static set<string> mapFilenamesUsed;
+  // when opening several maps, warn when a map filename is reused,
+  // maps analyzed at the same time share the set under the lock
+  static set<string>     mapFilenamesUsed;
+  static pthread_mutex_t mapFilenamesLock;
+
+
+  // translates between the coordinate frames for this
+  // map, every point of the map is set through it
+  CoordFrame frame;
 
 
   // note that the dimensions of the total map
@@ -226,11 +344,12 @@ public:
 
   // the available cliff heights: 0 is unplayable
   // low ground and levels 1, 2, 3 may be in play
-  u8*  mapHeight;
+  Grid<u8> mapHeight;
   u8   getHeight( point* t );
   void setHeight( point* t, u8 h );
 
   u8 getHeightCell( point* c );
+  u8 getHeightCell( cell    c );
 
 
   //////////////////////////////////////////////////
@@ -240,7 +359,7 @@ public:
 
   // an interdemiate layer to calculate accurate
   // terrain pathing
-  bool* mapCliffChanges;
+  Grid<bool> mapCliffChanges;
   bool  getMapCliffChange( point* c );
   void  setMapCliffChange( point* c, bool mcc );
 
@@ -248,8 +367,10 @@ public:
   // allowed in the cell and 1 (true) if allowed--
   // build pathing maps for cliff walkers also, and
   // do a version of paths with and without
-  // destructible rocks
-  bool* mapPathing;
+  // destructible rocks.  Each path type is its own
+  // plane of bits so whole rows can be worked on
+  // a word at a time
+  BitPlane mapPathing[NUM_PATH_TYPES];
 
   void  setPathing( point* c, PathType t, bool p );
 
@@ -273,6 +394,29 @@ public:
 
 
 
+  //////////////////////////////////////////////////
+  // in components.cpp
+  //////////////////////////////////////////////////
+  static int COMPONENT_NONE;
+
+  // every pathable cell is labeled with a connected
+  // component per path type, labels are dense from zero
+  // and unpathable cells (and the border) are COMPONENT_NONE
+  Grid<int> mapComponents[NUM_PATH_TYPES];
+  int  numComponents[NUM_PATH_TYPES];
+
+  int  findComponentRoot( int* parents, int i );
+
+  int  getComponent( point* c, PathType t );
+  void setComponent( point* c, PathType t, int label );
+
+  // cheap reachability tests, no shortest paths required
+  bool sameComponent( point* c0, point* c1, PathType t );
+  bool canReachBase ( point* c,  Base* b,   PathType t );
+
+
+
+
   //////////////////////////////////////////////////
   // in placedobjects.cpp
   //////////////////////////////////////////////////
@@ -291,6 +435,11 @@ public:
 
   void processPlacedObject( ObjectMode objMode, TiXmlElement* object );
 
+  // fills and footprints wait here until every
+  // placed object has been read
+  list<point>       pathingFills;
+  list<FootToApply> footsToApply;
+
   void applyFillsAndFootprints();
 
   void applyFill( point* c );
@@ -299,7 +448,11 @@ public:
                       map<int, point>* fillSet,
                       map<int, point>* workSet );
 
-  void applyFootprint( point* c, float rot, string* type, string* name );
+  // footprints only ever remove pathing, so they mark the
+  // cells to clear for each path type and the caller clears
+  // them from the pathing planes all at once
+  void applyFootprint( point* c, float rot, string* type, string* name,
+                       BitPlane* clears );
 
 
 
@@ -324,7 +477,46 @@ public:
   float weightedInfluenceDistance( StartLoc* sl, Base* b, point* p );
   float averageInfluence         ( StartLoc* sl, Base* b );
 
+  // the start location and base relations are flat tables
+  // in the arena, indexed by the dense StartLoc and Base
+  // indices, set up by calculateInfluence()
+  int numStartLocs;
+  int numBases;
+
+  inline int slPair( StartLoc* sl1, StartLoc* sl2 )
+  {
+    return sl1->index*numStartLocs + sl2->index;
+  }
+
+  inline int baseSL( Base* b, StartLoc* sl )
+  {
+    return b->index*numStartLocs + sl->index;
+  }
+
+  inline int baseSLPair( Base* b, StartLoc* sl1, StartLoc* sl2 )
+  {
+    return (b->index*numStartLocs + sl1->index)*numStartLocs + sl2->index;
+  }
+
+  // numStartLocs x numStartLocs, when SL1 spawns against
+  // SL2, the resource influence is a total of the resources
+  // of bases SL1 has influence over compared to SL2
+  float* sl2resourceInfluence;
+  float* sl2opennessInfluence;
+  float* sl2percentBalancedByResources;
+  float* sl2percentBalancedByOpenness;
+
+  // numBases x numStartLocs x numStartLocs, the influence
+  // SL1 exerts on the base when spawned against SL2 in 1v1
+  float* sl1vsl2_influence;
+
+  // numBases x numStartLocs, for main/nat/third classification
+  float* sl2averageInfluence;
+
+  // fraction of ground pathable cells seen by any
+  // watchtower, and fraction of those seen by two or more
   float watchtowerCoverage;
+  float watchtowerOverlap;
   void calculateWatchtowerCoverage();
 
 
@@ -337,8 +529,8 @@ public:
   // openness is a numerical value for a cell that
   // determines how far away the nearest unpathable
   // cell is, or how "open" the cell is
-  float* mapOpenness;
-  float* mapOpennessPrev;
+  Grid<float> mapOpenness    [NUM_PATH_TYPES];
+  Grid<float> mapOpennessPrev[NUM_PATH_TYPES];
 
   void computeOpenness( PathType t );
 
@@ -369,6 +561,64 @@ public:
 
 
 
+  //////////////////////////////////////////////////
+  // in vision.cpp
+  //////////////////////////////////////////////////
+  void prepVision();
+
+  void castLight( int cx, int cy, u8 viewerHeight, float range,
+                  int row, float slopeStart, float slopeEnd,
+                  int xx, int xy, int yx, int yy,
+                  BitPlane* visible );
+
+  float calculatePathVision( BitPlane* visible, PathType t );
+
+  // cliff level per cell and cells with an LoS blocker,
+  // what a viewer can't see past
+  Grid<u8> visionHeight;
+  BitPlane visionBlockers;
+
+  // what watchtowers see with line of sight, the fraction
+  // of ground pathable cells in it, and the fraction of
+  // cells on the main-to-main shortest paths in it
+  BitPlane watchtowerVision;
+  float    watchtowerVisionCoverage;
+  float    mainPathVision;
+
+
+
+  //////////////////////////////////////////////////
+  // in symmetry.cpp
+  //////////////////////////////////////////////////
+
+  // how many times the symmetry is applied before
+  // every cell is back where it started
+  int symmetryOrder( SymmetryType s );
+
+  // where a cell lands after applying a symmetry k times
+  void symmetricCell( SymmetryType s, int k,
+                      int pci, int pcj,
+                      int* pciOut, int* pcjOut );
+
+  // the fraction of cells whose pathing or height
+  // differs from their image, and for each path type
+  // whether its pathing matches exactly
+  float symmetryMismatch( SymmetryType s, bool* exact );
+
+  // fill in the shortest paths from src by transforming
+  // those of a symmetric partner that already has them,
+  // false if there is no such partner
+  bool deriveShortestPaths( Node* src, PathType t );
+
+
+
+  //////////////////////////////////////////////////
+  // in territory.cpp
+  //////////////////////////////////////////////////
+  void computeTerritory( PathType t );
+
+
+
   //////////////////////////////////////////////////
   // in dijkstra.cpp
   //////////////////////////////////////////////////
@@ -381,9 +631,14 @@ public:
   void buildPathGraph( PathType t );
   void computeShortestPaths( Node* src, PathType t );
 
+  // run the search from a source if nothing has asked for
+  // its shortest paths yet
+  void requireShortestPaths( Node* src, PathType t );
+
   // there is a disjoint graph of nodes for each path
-  // type all contained in this array
-  Node** mapPathNodes;
+  // type, one grid per type with a border of NULLs as
+  // wide as the furthest neighbor link
+  Grid<Node*> mapPathNodes[NUM_PATH_TYPES];
   Node*  getPathNode( point* c, PathType t );
   void   setPathNode( point* c, PathType t, Node* u );
 
@@ -400,10 +655,11 @@ public:
   //   *for path type t
   //   *from node ID=i to node ID=j you would use:
   //
-  //     (*(d[t][i]))[j]
+  //     d[t][i][j]
   //
-  map< int, vector<float>* > d [NUM_PATH_TYPES];
-  map< int, vector<Node*>* > pi[NUM_PATH_TYPES];
+  // the arrays are one entry per node and live in the arena
+  map< int, float* > d [NUM_PATH_TYPES];
+  map< int, Node** > pi[NUM_PATH_TYPES];
 
   // best used by other modules--if you ask for shortest distance
   // from points that are out of bounds or over unpathable cells
@@ -450,37 +706,97 @@ public:
   //////////////////////////////////////////////////
   // in render.cpp
   //////////////////////////////////////////////////
-  static int iLeft;
-  static int iBottom;
-  static int iRight;
-  static int iTop;
+  // the frame of the image being drawn, every
+  // thread drawing images has its own
+  static __thread int iLeft;
+  static __thread int iBottom;
+  static __thread int iRight;
+  static __thread int iTop;
   static int iDimT;
   static int iDimC;
 
   static int iFooterHeight;
 
+  static const char* fontface;
+
 
   int ix2png( int ix );
   int iy2png( int iy );
 
-  void resetPNGWriter( const char* strFileSuffix,
-                       int         iBorderLeft,
-                       int         iBorderRight,
-                       int         iBorderTop,
-                       int         iBorderBottom );
+  void resetCanvas( const char* strFileSuffix,
+                    int         iBorderLeft,
+                    int         iBorderRight,
+                    int         iBorderTop,
+                    int         iBorderBottom );
+  void resetCanvas( Canvas*     canvas,
+                    const char* strFileSuffix,
+                    int         iBorderLeft,
+                    int         iBorderRight,
+                    int         iBorderTop,
+                    int         iBorderBottom );
 
   void renderFooter();
 
+  // the terrain and static objects are cached in layers
+  // the first time they are needed, images paste them
+  static int iLayerMargin;
+
+  bool  layersBaked;
+  Layer terrainLayer;
+  Layer staticObjectsLayer;
+
+  void bakeLayers();
+  void pasteTerrain();
+  void pasteStaticObjects();
+  void renderStaticObjects();
+
   void renderTerrain();
   void plotTerrain( point* t );
-  void plotTerrainPoint( point* t, int* iPoints, int numPoints, Color* color );
+  void plotTerrainPoint( point* t, Stamp* stamp );
+
+  // icons drawn the same way everywhere are
+  // rendered once and blitted from then on
+  bool  stampsBaked;
+  Stamp stampTerrain1;
+  Stamp stampTerrain3;
+  Stamp stampDestruct;
+  Stamp stampWatchtower;
+
+  void bakeStamps();
+
+  void useCellImage   ( CellImage* ci );
+  void beginCellImage ( CellImage* ci );
+  void renderCells    ( vector<CellImage>* images );
+  void finishCellImage( CellImage* ci );
 
-  void renderImagePathing( const char* strOutPNG, PathType t );
   void renderPathing( PathType t );
   void plotPathing( point* c, PathType t );
+  void plotCellSpan( int pcx0, int pcx1, int pcy, Color* color );
 
   void renderOpenness( PathType t );
-  void plotOpenness( point* c, PathType t );
+  void plotOpenness( cell c, PathType t );
+  void opennessColor( cell c, PathType t, Color* color );
+  void renderOpennessLegend();
+
+  // every gradient the per-cell renderers shade with is
+  // baked into a table the first time one is needed, so
+  // shading a cell is a multiply and an index instead of
+  // building color names and looking them up
+  bool  gradientsBaked;
+  Color opennessLUT[NUM_OPENNESS_LUTS][GRADIENT_LUT_SIZE];
+  Color heatMapLUT [GRADIENT_LUT_SIZE];
+  u8    heatMapRGB [GRADIENT_LUT_SIZE][3];
+
+  void bakeGradients();
+
+  // zeroToOne is clamped to the ends of the table
+  inline Color* lookupGradient( Color* lut, float zeroToOne )
+  {
+    int i = (int)(zeroToOne * (float)GRADIENT_LUT_SIZE);
+    if( i < 0 )                  { i = 0; }
+    if( i > GRADIENT_LUT_SIZE-1 ) { i = GRADIENT_LUT_SIZE-1; }
+    return &(lut[i]);
+  }
 
   void openness2color( float oIn, Color* colorOut );
 
@@ -524,14 +840,41 @@ public:
 
   void renderImageInfluenceHeatMap( StartLoc* sl1, StartLoc* sl2 );
   void renderInfluenceHeatMap     ( StartLoc* sl1, StartLoc* sl2 );
-  void plotInfluenceHeatMap( point*    c,
-                             StartLoc* sl1,
-                             StartLoc* sl2 );
+
+  // every start location's weighted influence distance
+  // to each playable cell, row by row, the heat maps
+  // are drawn from these instead of path lookups
+  bool          influenceFieldsBaked;
+  vector<float> influenceFields;
+
+  // the start locations by index, so each job can go
+  // straight to its own
+  vector<StartLoc*> influenceFieldLocs;
+
+  void bakeInfluenceFields();
+  static void bakeInfluenceFieldJob( void* context, int job, int );
+
+  inline float* influenceField( StartLoc* sl )
+  {
+    return &(influenceFields[sl->index*cxDimPlayable*cyDimPlayable]);
+  }
 
 
   void renderImageInfluence( StartLoc* sl1, StartLoc* sl2 );
   void renderInfluence     ( StartLoc* sl1, StartLoc* sl2 );
 
+  void renderImagesShortestPaths( StartLoc* sl1, StartLoc* sl2 );
+
+  // the images for each pair of start locations are
+  // independent, so they are handed to the render
+  // workers to draw at the same time
+  void renderPairs( void (SC2Map::*renderPair)( StartLoc*, StartLoc* ) );
+  static void renderPairJob( void* context, int job, int worker );
+
+  // bake everything the workers share before they
+  // start, while they draw they only read the map
+  void prepRenderWorkers();
+
   void renderImageShortestPaths( char*  filename,
                                  char*  title,
                                  point* p0,
@@ -555,6 +898,7 @@ public:
   void plotAllShortestPaths( point* src, PathType t );
 
   void plotCellPoint( point* c, Color* color );
+  void plotCellPoint( cell   c, Color* color );
 
   void plotArrow( int x0, int y0, int x1, int y1,
                   Color* color );
@@ -569,7 +913,6 @@ public:
   void plotText( char* text,
                  int fontsize,
                  bool centered, int ix, int iy,
-                 float angle,
                  Color* colorf, // foreground
                  Color* colorb  // background
                );
@@ -579,7 +922,6 @@ public:
                            char** texts,
                            int fontsize,
                            bool centered, int ix, int iy,
-                           float angle,
                            Color** fores,
                            Color** backs
                          );
@@ -595,7 +937,13 @@ public:
   void renderTestPathingFills();
   void renderTestDetectChokes();
 
-  pngwriter* img;
+  // the canvas this thread is drawing into, each render
+  // worker draws into its own canvas of the map's
+  static __thread Canvas* img;
+  static __thread int     renderWorker;
+
+  vector<Canvas*> canvases;
+  WorkerPool*     renderPool;
 };
 
 
@@ -9,12 +9,31 @@
 #include "SC2MapAggregator.hpp"
 
 
+SC2MapAggregator::SC2MapAggregator()
+{
+  pthread_mutex_init( &summariesLock, NULL );
+}
+
+
+SC2MapAggregator::~SC2MapAggregator()
+{
+  pthread_mutex_destroy( &summariesLock );
+}
+
+
+static bool summaryBefore( const SC2MapSummary* ms1, const SC2MapSummary* ms2 )
+{
+  return ms1->order < ms2->order;
+}
+
+
 void SC2MapAggregator::buildOutputColumns()
 {
   addColumn( "Archive",                 "%s",     offsetof( SC2MapSummary, archiveName         ), COLTYPE_STR );
   addColumn( "Name In Output Files",    "%s",     offsetof( SC2MapSummary, fileName            ), COLTYPE_STR );
   addColumn( "Map",                     "%s",     offsetof( SC2MapSummary, mapName             ), COLTYPE_STR );
   addColumn( "Playable Size",           "%s",     offsetof( SC2MapSummary, playableSize        ), COLTYPE_STR );
+  addColumn( "Symmetry",                "%s",     offsetof( SC2MapSummary, symmetry            ), COLTYPE_STR );
   addColumn( "% Pathable",              "%.0f%%", offsetof( SC2MapSummary, percentPlayableCellsPathable ), COLTYPE_FLOAT );
   addColumn( "Num Start Locs",          "%d",     offsetof( SC2MapSummary, numStartLocs        ), COLTYPE_INT );
   addColumn( "Num Bases (inc. StrtLc)", "%d",     offsetof( SC2MapSummary, numBasesIncludingSL ), COLTYPE_INT );
@@ -42,6 +61,13 @@ void SC2MapAggregator::buildOutputColumns()
   addColumn( "Avg Openness", "%.2f", offsetof( SC2MapSummary, averageOpennessPathableCells ), COLTYPE_FLOAT );
 
   addColumn( "Watchtower Coverage of Pathable Cells", "%.1f%%", offsetof( SC2MapSummary, watchtowerCoverage ), COLTYPE_FLOAT );
+  addColumn( "Max Single Watchtower Coverage",        "%.1f%%", offsetof( SC2MapSummary, maxSingleWatchtowerCoverage ), COLTYPE_FLOAT );
+  addColumn( "Watchtower Overlap of Covered Cells",   "%.1f%%", offsetof( SC2MapSummary, watchtowerOverlap ), COLTYPE_FLOAT );
+  addColumn( "Watchtower LoS Coverage of Pathable Cells", "%.1f%%", offsetof( SC2MapSummary, watchtowerVisionCoverage ), COLTYPE_FLOAT );
+  addColumn( "Watchtower Vision of Main-to-Main Paths",   "%.1f%%", offsetof( SC2MapSummary, mainPathVision ), COLTYPE_FLOAT );
+
+  addColumn( "% Ground Territory Contested",     "%.1f%%", offsetof( SC2MapSummary, groundTerritoryContested ), COLTYPE_FLOAT );
+  addColumn( "% Cliff-Walk Territory Contested", "%.1f%%", offsetof( SC2MapSummary, cwalkTerritoryContested  ), COLTYPE_FLOAT );
 
   addColumn( "% Positional Balance", "%.1f%%", offsetof( SC2MapSummary, positionalBalancePercentage ), COLTYPE_FLOAT );
 
@@ -63,10 +89,12 @@ void SC2MapAggregator::addColumn( const char* title,
 }
 
 
-void SC2MapAggregator::aggregate( SC2Map* sc2map )
+void SC2MapAggregator::aggregate( SC2Map* sc2map, int order )
 {
   SC2MapSummary* ms = new SC2MapSummary();
 
+  ms->order = order;
+
   strcpy( ms->archiveName, sc2map->archiveWithExt.data()       );
   strcpy( ms->mapName,     sc2map->mapName.data()              );
   strcpy( ms->fileName,    sc2map->mapNameInOutputFiles.data() );
@@ -79,6 +107,8 @@ void SC2MapAggregator::aggregate( SC2Map* sc2map )
            sc2map->cxDimPlayable,
            sc2map->cyDimPlayable );
 
+  strncpy( ms->symmetry, sc2map->getSymmetryName(), MAXSTRLEN );
+
   // stuff to calculate over the cells of the map
   float numPlayableCells = ((float)sc2map->cxDimPlayable) *
                            ((float)sc2map->cyDimPlayable);
@@ -92,6 +122,25 @@ void SC2MapAggregator::aggregate( SC2Map* sc2map )
   ms->averageOpennessPathableCells = sc2map->opennessAvg[PATH_GROUND_WITHROCKS];
 
   ms->watchtowerCoverage           = sc2map->watchtowerCoverage * 100.0f;
+  ms->watchtowerOverlap            = sc2map->watchtowerOverlap  * 100.0f;
+  ms->watchtowerVisionCoverage     = sc2map->watchtowerVisionCoverage * 100.0f;
+  ms->mainPathVision               = sc2map->mainPathVision * 100.0f;
+
+  ms->groundTerritoryContested = sc2map->territoryContested[PATH_GROUND_WITHROCKS] * 100.0f;
+  ms->cwalkTerritoryContested  = sc2map->territoryContested[PATH_CWALK_WITHROCKS ] * 100.0f;
+
+  ms->maxSingleWatchtowerCoverage = 0.0f;
+  for( list<Watchtower*>::const_iterator wtItr = sc2map->watchtowers.begin();
+       wtItr != sc2map->watchtowers.end();
+       ++wtItr )
+  {
+    Watchtower* wt = *wtItr;
+
+    if( wt->coverage * 100.0f > ms->maxSingleWatchtowerCoverage )
+    {
+      ms->maxSingleWatchtowerCoverage = wt->coverage * 100.0f;
+    }
+  }
 
 
   // do the resources in kilos
@@ -192,14 +241,16 @@ void SC2MapAggregator::aggregate( SC2Map* sc2map )
         dAirTotalNat2Nat    += dAirNat2Nat;
       }
 
-      if( sl1->sl2percentBalancedByResources[sl2] < ms->positionalBalancePercentage )
+      int pair = sc2map->slPair( sl1, sl2 );
+
+      if( sc2map->sl2percentBalancedByResources[pair] < ms->positionalBalancePercentage )
       {
-        ms->positionalBalancePercentage = sl1->sl2percentBalancedByResources[sl2];
+        ms->positionalBalancePercentage = sc2map->sl2percentBalancedByResources[pair];
       }
 
-      if( sl1->sl2percentBalancedByOpenness[sl2] < ms->positionalBalancePercentage )
+      if( sc2map->sl2percentBalancedByOpenness[pair] < ms->positionalBalancePercentage )
       {
-        ms->positionalBalancePercentage = sl1->sl2percentBalancedByOpenness[sl2];
+        ms->positionalBalancePercentage = sc2map->sl2percentBalancedByOpenness[pair];
       }
     }
   }
@@ -213,7 +264,9 @@ void SC2MapAggregator::aggregate( SC2Map* sc2map )
   ms->avgAirDistanceNat2Nat      = dAirTotalNat2Nat    / ((float)startLocPairs);
 
 
+  pthread_mutex_lock( &summariesLock );
   summaries.push_back( ms );
+  pthread_mutex_unlock( &summariesLock );
 }
 
 
@@ -238,6 +291,8 @@ void SC2MapAggregator::writeToCSV( string* outputPath )
 
   printMessage( "Aggregate CSV is %s.\n\n", strOut.data() );
 
+  summaries.sort( &summaryBefore );
+
 
   // write out column headers
   int countColumns = 0;
@@ -14,6 +14,8 @@ using namespace std;
 
 struct SC2MapSummary
 {
+  int   order;
+
   char  archiveName[FILENAME_LENGTH];
   char  mapName    [FILENAME_LENGTH];
   char  fileName   [FILENAME_LENGTH];
@@ -21,6 +23,7 @@ struct SC2MapSummary
   int   cellWidth;
   int   cellHeight;
   char  playableSize[MAXSTRLEN];
+  char  symmetry    [MAXSTRLEN];
 
   float percentPlayableCellsPathable;
   //int numCellsGroundConnectedToMains; // --> classify as island?
@@ -68,6 +71,13 @@ struct SC2MapSummary
   // with rocks, and without?
 
   float watchtowerCoverage;
+  float watchtowerOverlap;
+  float maxSingleWatchtowerCoverage;
+  float watchtowerVisionCoverage;
+  float mainPathVision;
+
+  float groundTerritoryContested;
+  float cwalkTerritoryContested;
 
   float impactOfDestructibleRocksPercentage; // how much do rocks change distances? 0 -> 100%
 
@@ -95,6 +105,9 @@ class SC2MapAggregator
 {
 public:
 
+  SC2MapAggregator();
+  ~SC2MapAggregator();
+
   void buildOutputColumns();
 
   void addColumn( const char* title,
@@ -102,7 +115,10 @@ public:
                   int         offsetToValue,
                   ColumnType  type );
 
-  void aggregate( SC2Map* sc2map );
+  // maps can be aggregated from several threads, the
+  // order is where the map was found so the rows come
+  // out the same however the maps finished
+  void aggregate( SC2Map* sc2map, int order );
 
   void writeToCSV( string* outputPath );
 
@@ -110,6 +126,8 @@ protected:
 
   list<SC2MapSummary*> summaries;
   list<Column*>        outputColumns;
+
+  pthread_mutex_t summariesLock;
 };
 
 
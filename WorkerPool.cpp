@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "outstreams.hpp"
+#include "WorkerPool.hpp"
+
+
+WorkerPool::WorkerPool( int numWorkersIn )
+{
+  numWorkers = numWorkersIn < 1 ? 1 : numWorkersIn;
+
+  job      = NULL;
+  context  = NULL;
+  numJobs  = 0;
+  nextJob  = 0;
+  jobsDone = 0;
+  quitting = false;
+
+  pthread_mutex_init( &lock,       NULL );
+  pthread_cond_init ( &batchReady, NULL );
+  pthread_cond_init ( &batchDone,  NULL );
+
+  // worker 0 is whoever calls run(), it
+  // doesn't need a thread of its own
+  threads = new pthread_t[numWorkers];
+  starts  = new Start    [numWorkers];
+
+  for( int i = 1; i < numWorkers; ++i )
+  {
+    starts[i].pool   = this;
+    starts[i].worker = i;
+
+    if( pthread_create( &(threads[i]), NULL, &threadMain, &(starts[i]) ) != 0 )
+    {
+      printError( "Could not start worker thread %d.\n", i );
+      exit( -1 );
+    }
+  }
+}
+
+
+WorkerPool::~WorkerPool()
+{
+  pthread_mutex_lock( &lock );
+  quitting = true;
+  pthread_cond_broadcast( &batchReady );
+  pthread_mutex_unlock( &lock );
+
+  for( int i = 1; i < numWorkers; ++i )
+  {
+    pthread_join( threads[i], NULL );
+  }
+
+  pthread_cond_destroy ( &batchDone  );
+  pthread_cond_destroy ( &batchReady );
+  pthread_mutex_destroy( &lock       );
+
+  delete[] starts;
+  delete[] threads;
+}
+
+
+void* WorkerPool::threadMain( void* arg )
+{
+  Start*      start = (Start*)arg;
+  WorkerPool* pool  = start->pool;
+
+  pthread_mutex_lock( &(pool->lock) );
+
+  while( true )
+  {
+    while( !pool->quitting &&
+           (pool->job == NULL || pool->nextJob >= pool->numJobs) )
+    {
+      pthread_cond_wait( &(pool->batchReady), &(pool->lock) );
+    }
+
+    if( pool->quitting )
+    {
+      break;
+    }
+
+    pool->work( start->worker );
+  }
+
+  pthread_mutex_unlock( &(pool->lock) );
+  return NULL;
+}
+
+
+void WorkerPool::work( int worker )
+{
+  while( job != NULL && nextJob < numJobs )
+  {
+    int i = nextJob;
+    ++nextJob;
+
+    WorkerJob f = job;
+    void*     c = context;
+
+    pthread_mutex_unlock( &lock );
+    f( c, i, worker );
+    pthread_mutex_lock( &lock );
+
+    ++jobsDone;
+    if( jobsDone == numJobs )
+    {
+      pthread_cond_broadcast( &batchDone );
+    }
+  }
+}
+
+
+void WorkerPool::run( int numJobsIn, WorkerJob jobIn, void* contextIn )
+{
+  if( numJobsIn <= 0 )
+  {
+    return;
+  }
+
+  pthread_mutex_lock( &lock );
+
+  job      = jobIn;
+  context  = contextIn;
+  numJobs  = numJobsIn;
+  nextJob  = 0;
+  jobsDone = 0;
+
+  pthread_cond_broadcast( &batchReady );
+
+  work( 0 );
+
+  while( jobsDone < numJobs )
+  {
+    pthread_cond_wait( &batchDone, &lock );
+  }
+
+  // nothing is handed out between batches
+  job     = NULL;
+  context = NULL;
+
+  pthread_mutex_unlock( &lock );
+}
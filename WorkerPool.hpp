@@ -0,0 +1,63 @@
+#ifndef ___WorkerPool_hpp___
+#define ___WorkerPool_hpp___
+
+#include <pthread.h>
+
+
+// a job is called with its number in the batch and
+// the number of the worker running it, worker 0 is
+// always the thread that called run()
+typedef void (*WorkerJob)( void* context, int job, int worker );
+
+
+// a fixed set of threads that work through a batch of
+// numbered jobs together.  The thread that hands over
+// the batch works on it too, so a pool of one thread
+// just runs the jobs in order with no threads at all.
+class WorkerPool
+{
+public:
+
+  WorkerPool( int numWorkersIn );
+  ~WorkerPool();
+
+  // returns once every job in the batch is done
+  void run( int numJobsIn, WorkerJob jobIn, void* contextIn );
+
+  int numWorkers;
+
+private:
+
+  static void* threadMain( void* arg );
+
+  // take jobs until there are none left, the lock
+  // is held on the way in and on the way out
+  void work( int worker );
+
+  pthread_t*      threads;
+  pthread_mutex_t lock;
+  pthread_cond_t  batchReady;
+  pthread_cond_t  batchDone;
+
+  WorkerJob job;
+  void*     context;
+  int       numJobs;
+  int       nextJob;
+  int       jobsDone;
+  bool      quitting;
+
+  // the threads find their worker numbers here
+  struct Start
+  {
+    WorkerPool* pool;
+    int         worker;
+  };
+  Start* starts;
+
+  // pools own their threads, don't copy them around
+  WorkerPool( const WorkerPool& );
+  WorkerPool& operator=( const WorkerPool& );
+};
+
+
+#endif // ___WorkerPool_hpp___
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 #include "outstreams.hpp"
 #include "coordinates.hpp"
@@ -52,8 +53,9 @@ void SC2Map::locateBases() {
     if( b == NULL )
     {
       // start a new base for this resource
-      b = new Base();
+      b = arena.makeOwned<Base>();
       b->loc.set( &(r->loc) );
+      b->index = bases.size();
 
       b->isInMain = false;
       
@@ -84,7 +86,7 @@ void SC2Map::locateBases() {
       mxTotal /= b->resources.size();
       myTotal /= b->resources.size();
 
-      b->loc.mSet( mxTotal, myTotal );
+      b->loc.mSet( &frame, mxTotal, myTotal );
     }
   }
 }
@@ -232,8 +234,8 @@ void SC2Map::assignNearestPathNodes() {
       {
         // if so, put one entry in the patch and exit
         // early
-        (b->node2patchDistance[t])[n] =
-          getShortestAirDistance( &(n->loc), &(b->loc) );
+        b->node2patchDistance[t].add( n->id,
+                                      getShortestAirDistance( &(n->loc), &(b->loc) ) );
         continue;
       }
 
@@ -257,15 +259,15 @@ void SC2Map::assignNearestPathNodes() {
 
         for( int j = 0; j < numCellsToCast; ++j )
         {
-          c.pcSet( c.pcx + dxs[i], c.pcy + dys[i] );
+          c.pcSet( &frame, c.pcx + dxs[i], c.pcy + dys[i] );
 
           n = getPathNode( &c, (PathType)t );
           if( n != NULL )
           {
             // if so, put an entry in the patch and we're done
             // looking in this direction
-            (b->node2patchDistance[t])[n] =
-              getShortestAirDistance( &(n->loc), &(b->loc) );
+            b->node2patchDistance[t].add( n->id,
+                                          getShortestAirDistance( &(n->loc), &(b->loc) ) );
 
             foundOne = true;
             break;
@@ -331,7 +333,7 @@ void SC2Map::nameStartLocs() {
   // set a point at the playable terrain's center
   // to calculate the angle to a start location
   point center;
-  center.ptSet( txDimPlayable/2,
+  center.ptSet( &frame, txDimPlayable/2,
                 tyDimPlayable/2 );
 
   for( list<StartLoc*>::const_iterator itr = startLocs.begin();
@@ -397,7 +399,7 @@ void SC2Map::calculateAverageOpennessPerBase() {
 
     b->avgOpennessForNeighborhood =
       calculateAverageOpennessInNeighborhood( &(b->loc),
-                                              getfConstant( "baseAvgOpennessNeighborhoodRadius" ),
+                                              rc.baseAvgOpennessNeighborhoodRadius,
                                               PATH_GROUND_WITHROCKS );
   }
 }
@@ -409,25 +411,30 @@ void SC2Map::calculateInfluence() {
   // separately for EACH PAIR of start locations, so we
   // are considering all the spawn configurations
 
-  // initialize this calc
-  for( list<StartLoc*>::const_iterator slItr1 = startLocs.begin();
-       slItr1 != startLocs.end();
-       ++slItr1 )
-  {
-    StartLoc* sl1 = *slItr1;
-
-    for( list<StartLoc*>::const_iterator slItr2 = startLocs.begin();
-         slItr2 != startLocs.end();
-         ++slItr2 )
-    {
-      StartLoc* sl2 = *slItr2;
-
-      if( sl1 == sl2 ) { continue; }
-
-      sl1->sl2resourceInfluence[sl2] = 0.0f;
-      sl1->sl2opennessInfluence[sl2] = 0.0f;
-    }
-  }
+  // initialize this calc, every table is indexed by the
+  // dense start location and base indices so make them
+  // all now that the bases are settled
+  numStartLocs = startLocs.size();
+  numBases     = bases.size();
+
+  int numSLPairs     = numStartLocs*numStartLocs;
+  int numBaseSL      = numBases*numStartLocs;
+  int numBaseSLPairs = numBases*numSLPairs;
+
+  sl2resourceInfluence          = arena.makeArray<float>( numSLPairs     );
+  sl2opennessInfluence          = arena.makeArray<float>( numSLPairs     );
+  sl2percentBalancedByResources = arena.makeArray<float>( numSLPairs     );
+  sl2percentBalancedByOpenness  = arena.makeArray<float>( numSLPairs     );
+  sl1vsl2_influence             = arena.makeArray<float>( numBaseSLPairs );
+  sl2averageInfluence           = arena.makeArray<float>( numBaseSL      );
+
+  // the diagonals (a start location against itself) are
+  // never used, zero everything so they are harmless
+  memset( sl2resourceInfluence,          0, numSLPairs    *sizeof( float ) );
+  memset( sl2opennessInfluence,          0, numSLPairs    *sizeof( float ) );
+  memset( sl2percentBalancedByResources, 0, numSLPairs    *sizeof( float ) );
+  memset( sl2percentBalancedByOpenness,  0, numSLPairs    *sizeof( float ) );
+  memset( sl1vsl2_influence,             0, numBaseSLPairs*sizeof( float ) );
 
   // how much influence, as a percentage, does each
   // start location IN A PAIR exert on a given base?
@@ -443,8 +450,6 @@ void SC2Map::calculateInfluence() {
     {
       StartLoc* sl1 = *slItr1;
 
-      map<StartLoc*, float>* innerMap = new map<StartLoc*, float>;
-
       float d1 = weightedInfluenceDistance( sl1, b, NULL );
 
       for( list<StartLoc*>::const_iterator slItr2 = startLocs.begin();
@@ -463,10 +468,8 @@ void SC2Map::calculateInfluence() {
 
         float pInfl = pNeutral + ((dAverage - d1) / dTotal);
 
-        innerMap->insert( make_pair( sl2, 100.0f * pInfl ) );
+        sl1vsl2_influence[baseSLPair( b, sl1, sl2 )] = 100.0f * pInfl;
       }
-
-      b->sl1vsl2_influence.insert( make_pair( sl1, innerMap ) );
     }
   }
 
@@ -483,7 +486,7 @@ void SC2Map::calculateInfluence() {
     {
       Base* b = *bItr;
 
-      b->sl2averageInfluence[sl] = averageInfluence( sl, b );
+      sl2averageInfluence[baseSL( b, sl )] = averageInfluence( sl, b );
     }
   }
 }
@@ -522,7 +525,7 @@ float SC2Map::weightedInfluenceDistance( StartLoc* sl, Base* b, point* p ) {
   {
     dGround = dNoInfluence;
   }
-  dwi += getfConstant( "influenceWeightGround" ) * dGround;
+  dwi += rc.influenceWeightGround * dGround;
 
   float dCWalk;
   if( b != NULL )
@@ -535,7 +538,7 @@ float SC2Map::weightedInfluenceDistance( StartLoc* sl, Base* b, point* p ) {
   {
     dCWalk = dNoInfluence;
   }
-  dwi += getfConstant( "influenceWeightCWalk" ) * dCWalk;
+  dwi += rc.influenceWeightCWalk * dCWalk;
 
   float dAir;
   if( b != NULL )
@@ -544,7 +547,7 @@ float SC2Map::weightedInfluenceDistance( StartLoc* sl, Base* b, point* p ) {
   } else {
     dAir = getShortestAirDistance( &(sl->loc), p );
   }
-  dwi += getfConstant( "influenceWeightAir" ) * dAir;
+  dwi += rc.influenceWeightAir * dAir;
 
   return dwi;
 }
@@ -559,18 +562,14 @@ float SC2Map::averageInfluence( StartLoc* sl, Base* b ) {
     return 0.0f;
   }
 
-  float total = 0.0f;
-  map<StartLoc*, float>* innerMap = b->sl1vsl2_influence[sl];
+  // this start location's row of the base's table, the
+  // entry against itself is zero so just sum the row
+  float  total = 0.0f;
+  float* row   = sl1vsl2_influence + baseSL( b, sl )*numStartLocs;
 
-  for( list<StartLoc*>::const_iterator slItr = startLocs.begin();
-       slItr != startLocs.end();
-       ++slItr )
+  for( int i = 0; i < numStartLocs; ++i )
   {
-    StartLoc* sl2 = *slItr;
-
-    if( sl == sl2 ) { continue; }
-
-    total += (*innerMap)[sl2];
+    total += row[i];
   }
 
   return total / (float)(startLocs.size() - 1);
@@ -586,7 +585,7 @@ void SC2Map::assignMainNatThirdIslands() {
   // don't even consider a base as a main, nat or
   // third unless the start loc exerts an influence
   // greater than a threshold
-  float minInfluence = getfConstant( "minInfluenceToConsiderNatOrThird" );
+  float minInfluence = rc.minInfluenceToConsiderNatOrThird;
 
   
   // to know if a base is an island or semi island we have to
@@ -628,23 +627,21 @@ void SC2Map::assignMainNatThirdIslands() {
       Base* b = *bItr;
       
       
-      // do island classifications
-      float dGroundWR = getShortestPathDistance( &(sl->loc), b, PATH_GROUND_WITHROCKS );
-      float dGroundNR = getShortestPathDistance( &(sl->loc), b, PATH_GROUND_NOROCKS   );
-
-      if( !SC2Map::effectivelyInfinity( dGroundNR ) ) {
+      // do island classifications, only reachability matters
+      // here so compare components instead of searching paths
+      if( canReachBase( &(sl->loc), b, PATH_GROUND_NOROCKS ) ) {
         // if there is a path with no rocks this base is NOT an island
         islands.erase( b );
       }
 
-      if( !SC2Map::effectivelyInfinity( dGroundWR ) ) {
+      if( canReachBase( &(sl->loc), b, PATH_GROUND_WITHROCKS ) ) {
         // if there is a path with rocks this base is NOT a semi island
         semiislands.erase( b );
       }
 
       
       // now do main/nat/third because we might jump out of this iteration
-      float bInfluence = b->sl2averageInfluence[sl];
+      float bInfluence = sl2averageInfluence[baseSL( b, sl )];
 
       if( bInfluence < minInfluence ) {
         continue;
@@ -652,7 +649,7 @@ void SC2Map::assignMainNatThirdIslands() {
 
       // should this base beat out the current third?
       if( sl->thirdBase == NULL ||
-          sl->thirdBase->sl2averageInfluence[sl] < bInfluence )
+          sl2averageInfluence[baseSL( sl->thirdBase, sl )] < bInfluence )
       {
         sl->thirdBase = b;
         b->sl         = sl;
@@ -663,7 +660,7 @@ void SC2Map::assignMainNatThirdIslands() {
 
       // should this base beat out the current nat?
       if( sl->natBase == NULL ||
-          sl->natBase->sl2averageInfluence[sl] < bInfluence )
+          sl2averageInfluence[baseSL( sl->natBase, sl )] < bInfluence )
       {
         sl->thirdBase = sl->natBase;
         if( sl->thirdBase != NULL ) {
@@ -679,7 +676,7 @@ void SC2Map::assignMainNatThirdIslands() {
 
       // should this base beat out the current main?
       if( sl->mainBase == NULL ||
-          sl->mainBase->sl2averageInfluence[sl] < bInfluence )
+          sl2averageInfluence[baseSL( sl->mainBase, sl )] < bInfluence )
       {
         sl->natBase = sl->mainBase;
         if( sl->natBase != NULL ) {
@@ -737,17 +734,15 @@ void SC2Map::calculatePositionalBalance() {
       {
         Base* b = *bItr;
 
-        map<StartLoc*, float>* innerMap1 = b->sl1vsl2_influence[sl1];
-        map<StartLoc*, float>* innerMap2 = b->sl1vsl2_influence[sl2];
-
-        float di = (*innerMap1)[sl2] - (*innerMap2)[sl1];
+        float di = sl1vsl2_influence[baseSLPair( b, sl1, sl2 )] -
+                   sl1vsl2_influence[baseSLPair( b, sl2, sl1 )];
 
         if( di < 0.0f ) {
           di = 0.0f;
         }
 
-        sl1->sl2resourceInfluence[sl2] += b->resourceTotal              * di;
-        sl1->sl2opennessInfluence[sl2] += b->avgOpennessForNeighborhood * di;
+        sl2resourceInfluence[slPair( sl1, sl2 )] += b->resourceTotal              * di;
+        sl2opennessInfluence[slPair( sl1, sl2 )] += b->avgOpennessForNeighborhood * di;
       }
     }
   }
@@ -773,14 +768,14 @@ void SC2Map::calculatePositionalBalance() {
       // balanced like this:  SL1 is 98% vs. SL2 at 102%
       //sl1->sl2percentBalancedByResources[sl2] = 200.0f * r;
 
-      sl1->sl2percentBalancedByResources[sl2] = 100.0f *
-                                                sl1->sl2resourceInfluence[sl2] /
-                                                sl2->sl2resourceInfluence[sl1];
+      sl2percentBalancedByResources[slPair( sl1, sl2 )] = 100.0f *
+                                                          sl2resourceInfluence[slPair( sl1, sl2 )] /
+                                                          sl2resourceInfluence[slPair( sl2, sl1 )];
 
       // for openness, just get percent difference
-      sl1->sl2percentBalancedByOpenness[sl2] = 100.0f *
-                                               sl1->sl2opennessInfluence[sl2] /
-                                               sl2->sl2opennessInfluence[sl1];
+      sl2percentBalancedByOpenness[slPair( sl1, sl2 )] = 100.0f *
+                                                         sl2opennessInfluence[slPair( sl1, sl2 )] /
+                                                         sl2opennessInfluence[slPair( sl2, sl1 )];
     }
   }
 }
@@ -838,7 +833,7 @@ void SC2Map::computeSpaceInMain() {
        
         Base* b = *bItr;
       
-        if( p2pDistance( &c, &(b->loc) ) < getfConstant( "inMainBaseRadius" ) ) {
+        if( p2pDistance( &c, &(b->loc) ) < rc.inMainBaseRadius ) {
           b->isInMain = true;
         }
       }
@@ -861,7 +856,7 @@ void SC2Map::findSpace( int dx, int dy, point* c,
                         map<int, point>* workSet,
                         point* choke ) {
   point cn;
-  cn.pcSet( c->pcx + dx, c->pcy + dy );
+  cn.pcSet( &frame, c->pcx + dx, c->pcy + dy );
 
   if( !isPlayableCell( &cn ) )
   {
@@ -873,7 +868,7 @@ void SC2Map::findSpace( int dx, int dy, point* c,
     return;
   }
 
-  if( p2pDistance( &cn, choke ) < getfConstant( "spaceInMainChokeRadius" ) )
+  if( p2pDistance( &cn, choke ) < rc.spaceInMainChokeRadius )
   {
     return;
   }
@@ -893,7 +888,26 @@ void SC2Map::findSpace( int dx, int dy, point* c,
 
 void SC2Map::calculateWatchtowerCoverage() {
 
-  set<int> cellsCovered;
+  // coverage is measured against the ground pathable cells
+  BitPlane* ground = &(mapPathing[PATH_GROUND_NOROCKS]);
+
+  BitPlane covered;
+  BitPlane overlap;
+  BitPlane tower;
+  covered.resize( cxDimPlayable, cyDimPlayable );
+  overlap.resize( cxDimPlayable, cyDimPlayable );
+  tower  .resize( cxDimPlayable, cyDimPlayable );
+
+  int wordsPerRow = tower.wordsPerRow;
+
+  float numGround = (float)numPathableCells[PATH_GROUND_NOROCKS];
+
+  // the disc is one span of cells per row, the half-width
+  // of the span at each row offset depends only on the
+  // range, and towers nearly all share one range, so each
+  // distinct range works its half-widths out just once
+  // (-1 for a row the disc misses)
+  map< float, vector<int> > halfWidthsByRange;
 
   for( list<Watchtower*>::const_iterator wtItr = watchtowers.begin();
        wtItr != watchtowers.end();
@@ -903,31 +917,94 @@ void SC2Map::calculateWatchtowerCoverage() {
 
     int r = (int)(wt->range + 1.0f);
 
-    for( int pci = -r; pci < r; ++pci )
+    // the rows of the sight disc this tower touches
+    int row0 = wt->loc.pcy - r;
+    int row1 = wt->loc.pcy + r;
+    if( row0 < 0             ) { row0 = 0;             }
+    if( row1 > cyDimPlayable ) { row1 = cyDimPlayable; }
+
+    if( row0 >= row1 )
     {
+      wt->coverage = 0.0f;
+      continue;
+    }
+
+    memset( tower.row( row0 ),
+            0,
+            (row1 - row0)*wordsPerRow*sizeof( u64 ) );
+
+    vector<int>* halfWidths = &(halfWidthsByRange[wt->range]);
+    if( halfWidths->empty() )
+    {
+      halfWidths->resize( 2*r );
+
       for( int pcj = -r; pcj < r; ++pcj )
       {
-        float xsq = (float)(pci*pci);
-        float ysq = (float)(pcj*pcj);
-        if( sqrt( xsq + ysq ) > wt->range )
+        float hsq = wt->range*wt->range - (float)(pcj*pcj);
+
+        int h = -1;
+        if( hsq >= 0.0f )
         {
-          continue;
+          h = (int)sqrt( hsq );
+          if( h > r - 1 ) { h = r - 1; }
         }
 
-        point c;
-        c.pcSet( wt->loc.pcx + pci,
-                 wt->loc.pcy + pcj );
+        (*halfWidths)[pcj + r] = h;
+      }
+    }
 
-        if( isPlayableCell( &c ) &&
-            getPathing( &c, PATH_GROUND_NOROCKS ) )
-        {
-          cellsCovered.insert( c.pcx + c.pcy*cxDimPlayable );
-        }
+    for( int pcj = -r; pcj < r; ++pcj )
+    {
+      int y = wt->loc.pcy + pcj;
+      if( y < 0 || y >= cyDimPlayable )
+      {
+        continue;
+      }
+
+      int h = (*halfWidths)[pcj + r];
+      if( h < 0 )
+      {
+        continue;
       }
+
+      int x0 = wt->loc.pcx - h;
+      int x1 = wt->loc.pcx + h;
+      if( x0 < 0                 ) { x0 = 0;                 }
+      if( x1 > cxDimPlayable - 1 ) { x1 = cxDimPlayable - 1; }
+      if( x0 > x1 )
+      {
+        continue;
+      }
+
+      tower.setSpan( y, x0, x1 );
     }
+
+    // a whole word of cells at a time, count what this
+    // tower sees and note cells already seen by another
+    int cellsSeen = 0;
+
+    for( int i = row0*wordsPerRow; i < row1*wordsPerRow; ++i )
+    {
+      u64 seen = tower.words[i] & ground->words[i];
+
+      cellsSeen        += __builtin_popcountll( seen );
+      overlap.words[i] |= covered.words[i] & seen;
+      covered.words[i] |= seen;
+    }
+
+    wt->coverage = (float)cellsSeen / numGround;
   }
 
-  watchtowerCoverage =
-    (float)cellsCovered.size() /
-    (float)numPathableCells[PATH_GROUND_NOROCKS];
+  int cellsCovered    = covered.count();
+  int cellsOverlapped = overlap.count();
+
+  watchtowerCoverage = (float)cellsCovered / numGround;
+
+  // of the cells that are covered, how many are seen by
+  // more than one watchtower?
+  watchtowerOverlap = 0.0f;
+  if( cellsCovered > 0 )
+  {
+    watchtowerOverlap = (float)cellsOverlapped / (float)cellsCovered;
+  }
 }
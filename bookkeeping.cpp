@@ -17,20 +17,8 @@
 
 void SC2Map::countPathableCells()
 {
-  for( int pci = 0; pci < cxDimPlayable; ++pci )
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
   {
-    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
-    {
-      point c;
-      c.pcSet( pci, pcj );
-
-      for( int t = 0; t < NUM_PATH_TYPES; ++t )
-      {
-        if( getPathing( &c, (PathType)t ) )
-        {
-          ++numPathableCells[t];
-        }
-      }
-    }
+    numPathableCells[t] = mapPathing[t].count();
   }
 }
@@ -0,0 +1,206 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#include "outstreams.hpp"
+#include "coordinates.hpp"
+#include "SC2Map.hpp"
+
+
+
+int SC2Map::COMPONENT_NONE = -1;
+
+
+// label every pathable cell with the connected component
+// it belongs to, for each path type.  Two cells with different
+// labels can never reach one another, so questions like "is
+// this base an island?" are a label compare instead of a
+// shortest path search.
+//
+// The path graph links diagonal neighbors whenever both cells
+// are pathable, and the knight's jump links always have pathable
+// cells in between, so 8-connectivity of the pathing map is
+// exactly the connectivity of the path graph.
+void SC2Map::labelComponents()
+{
+  // provisional labels are merged with a union-find
+  // forest, there can't be more labels than cells
+  int* parents = new int[cxDimPlayable*cyDimPlayable];
+
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    // the border lets the scan look at neighbors
+    // off the edge without any bounds checks
+    Grid<int>* labels = &(mapComponents[t]);
+    labels->resize( cxDimPlayable, cyDimPlayable, 1, COMPONENT_NONE );
+
+    int numLabels = 0;
+
+    // first pass, scan rows bottom to top and give each
+    // pathable cell the label of any neighbor we already
+    // visited, recording equivalences when they disagree
+    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+    {
+      for( int pci = 0; pci < cxDimPlayable; ++pci )
+      {
+        if( !mapPathing[t].get( pci, pcj ) )
+        {
+          continue;
+        }
+
+        // west, south-west, south and south-east
+        // have already been visited
+        int dxs[] = { -1, -1, 0, 1 };
+        int dys[] = {  0, -1, -1, -1 };
+
+        int label = COMPONENT_NONE;
+
+        for( int i = 0; i < 4; ++i )
+        {
+          // visited neighbors are labeled if they are pathable
+          int nLabel = labels->at( pci + dxs[i], pcj + dys[i] );
+
+          if( nLabel == COMPONENT_NONE )
+          {
+            continue;
+          }
+
+          nLabel = findComponentRoot( parents, nLabel );
+
+          if( label == COMPONENT_NONE )
+          {
+            label = nLabel;
+
+          } else if( nLabel != label ) {
+            // always hang the larger root under the smaller
+            if( nLabel < label )
+            {
+              parents[label] = nLabel;
+              label = nLabel;
+            } else {
+              parents[nLabel] = label;
+            }
+          }
+        }
+
+        if( label == COMPONENT_NONE )
+        {
+          label = numLabels;
+          parents[label] = label;
+          ++numLabels;
+        }
+
+        labels->at( pci, pcj ) = label;
+      }
+    }
+
+    // second pass, resolve every provisional label to its
+    // root and renumber the roots densely from zero
+    int* dense = new int[numLabels + 1];
+    numComponents[t] = 0;
+
+    for( int i = 0; i < numLabels; ++i )
+    {
+      int root = findComponentRoot( parents, i );
+      if( root == i )
+      {
+        dense[i] = numComponents[t];
+        ++numComponents[t];
+      } else {
+        dense[i] = dense[root];
+      }
+    }
+
+    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+    {
+      int* row = labels->row( pcj );
+
+      for( int pci = 0; pci < cxDimPlayable; ++pci )
+      {
+        if( row[pci] != COMPONENT_NONE )
+        {
+          row[pci] = dense[row[pci]];
+        }
+      }
+    }
+
+    delete[] dense;
+  }
+
+  delete[] parents;
+}
+
+
+int SC2Map::findComponentRoot( int* parents, int i )
+{
+  int root = i;
+  while( parents[root] != root )
+  {
+    root = parents[root];
+  }
+
+  // compress the path so later finds are quick
+  while( parents[i] != root )
+  {
+    int next = parents[i];
+    parents[i] = root;
+    i = next;
+  }
+
+  return root;
+}
+
+
+void SC2Map::setComponent( point* c, PathType t, int label )
+{
+  mapComponents[t].set( c->pcx, c->pcy, label );
+}
+
+
+int SC2Map::getComponent( point* c, PathType t )
+{
+  if( !isPlayableCell( c ) )
+  {
+    // out of bounds cells are not in any component,
+    // just like unpathable cells
+    return COMPONENT_NONE;
+  }
+  return mapComponents[t].at( c->pcx, c->pcy );
+}
+
+
+bool SC2Map::sameComponent( point* c0, point* c1, PathType t )
+{
+  int label = getComponent( c0, t );
+
+  return label != COMPONENT_NONE &&
+         label == getComponent( c1, t );
+}
+
+
+// a base is reachable from a point if any of the path
+// nodes that patch the base into the path graph share
+// a component with the point
+bool SC2Map::canReachBase( point* c, Base* b, PathType t )
+{
+  int label = getComponent( c, t );
+
+  if( label == COMPONENT_NONE )
+  {
+    return false;
+  }
+
+  PatchNodes* patches = &(b->node2patchDistance[t]);
+
+  for( int i = 0; i < patches->count; ++i )
+  {
+    Node* v = nodes[t][patches->entries[i].id];
+
+    if( getComponent( &(v->loc), t ) == label )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -122,15 +122,30 @@ void createInternalConfig( Config* c )
   c->fConstants["minInfluenceToConsiderNatOrThird"] = 47.0f;
 
   c->fConstants["chokeDetectionThreshhold"] = 12.0f;
+  c->fConstants["chokeDetectionThreshold" ] = 12.0f;
   c->fConstants["chokeDetectionAgreement" ] = 7.0f;
 
   c->fConstants["spaceInMainChokeRadius"] = 8.0f;
 
+  c->fConstants["inMainBaseRadius"] = 6.0f;
+
+  c->fConstants["territoryContestedMargin"] = 6.0f;
+
+  c->fConstants["symmetryTolerance"] = 0.02f;
+
   c->fConstants["influenceWeightGround" ] = 0.70f;
   c->fConstants["influenceWeightCWalk"  ] = 0.10f;
   c->fConstants["influenceWeightAir"    ] = 0.20f;
 
 
+  c->iConstants["numOpennessGradientColors"] = 2;
+  c->iConstants["influenceHeatMapRepeat"   ] = 6;
+  c->iConstants["influenceHeatMapBlendMode"] = 1;
+
+  c->iConstants["renderThreads"] = 4;
+  c->iConstants["encodeThreads"] = 4;
+
+
   c->colors["defaultTxtFg"] = Color( 1.0f, 1.0f, 1.0f );
   c->colors["defaultTxtBg"] = Color( 0.0f, 0.0f, 0.0f );
 
@@ -1077,6 +1092,66 @@ void readOutputConfig( string* path, Config* c )
       }
       c->outputPath.assign( path );
 
+    } else if( option == "pngCompression" ) {
+      token = strtok( NULL, delims );
+      if( token == NULL )
+      {
+        printWarning( "Expected a compression level at %s:%d, ignoring line.\n",
+                      configFilename.data(),
+                      lineNum );
+        continue;
+      }
+
+      int level;
+      if( sscanf( token, "%d", &level ) != 1 || level < 0 || level > 9 )
+      {
+        printWarning( "Compression level '%s' at %s:%d is not 0 to 9, ignoring line.\n",
+                      token,
+                      configFilename.data(),
+                      lineNum );
+        continue;
+      }
+      c->pngProfile.compressionLevel = level;
+
+    } else if( option == "pngFilter" ) {
+      token = strtok( NULL, delims );
+      if( token == NULL )
+      {
+        printWarning( "Expected a filter at %s:%d, ignoring line.\n",
+                      configFilename.data(),
+                      lineNum );
+        continue;
+      }
+
+      string filter( token );
+      trimTrailingSpaces( &filter );
+      trimLeadingSpaces ( &filter );
+
+      if( filter == "default" ) {
+        c->pngProfile.filter = PNGFILTER_DEFAULT;
+      } else if( filter == "none" ) {
+        c->pngProfile.filter = PNGFILTER_NONE;
+      } else if( filter == "sub" ) {
+        c->pngProfile.filter = PNGFILTER_SUB;
+      } else if( filter == "up" ) {
+        c->pngProfile.filter = PNGFILTER_UP;
+      } else if( filter == "avg" ) {
+        c->pngProfile.filter = PNGFILTER_AVG;
+      } else if( filter == "paeth" ) {
+        c->pngProfile.filter = PNGFILTER_PAETH;
+      } else if( filter == "all" ) {
+        c->pngProfile.filter = PNGFILTER_ALL;
+      } else {
+        printWarning( "Unrecognized filter '%s' at %s:%d, ignoring line.\n",
+                      filter.data(),
+                      configFilename.data(),
+                      lineNum );
+        continue;
+      }
+
+    } else if( option == "pngPalette" ) {
+      c->pngProfile.palette = true;
+
     } else {
       // all other options are just present or not
 
@@ -1113,6 +1188,59 @@ void readOutputConfig( string* path, Config* c )
 
 
 
+// settle every field of the resolved config from the
+// current configs, do this once the map's local config
+// has been read and before any analysis
+void SC2Map::resolveConfig()
+{
+  rc.defaultMineralAmount              = getfConstant( "defaultMineralAmount"              );
+  rc.defaultGeyserAmount               = getfConstant( "defaultGeyserAmount"               );
+  rc.baseAvgOpennessNeighborhoodRadius = getfConstant( "baseAvgOpennessNeighborhoodRadius" );
+  rc.minInfluenceToConsiderNatOrThird  = getfConstant( "minInfluenceToConsiderNatOrThird"  );
+  rc.chokeDetectionThreshold           = getfConstant( "chokeDetectionThreshold"           );
+  rc.chokeDetectionAgreement           = getfConstant( "chokeDetectionAgreement"           );
+  rc.spaceInMainChokeRadius            = getfConstant( "spaceInMainChokeRadius"            );
+  rc.inMainBaseRadius                  = getfConstant( "inMainBaseRadius"                  );
+  rc.territoryContestedMargin          = getfConstant( "territoryContestedMargin"          );
+  rc.symmetryTolerance                 = getfConstant( "symmetryTolerance"                 );
+  rc.influenceWeightGround             = getfConstant( "influenceWeightGround"             );
+  rc.influenceWeightCWalk              = getfConstant( "influenceWeightCWalk"              );
+  rc.influenceWeightAir                = getfConstant( "influenceWeightAir"                );
+
+  rc.opennessRenderMax         = getfConstant( "opennessRenderMax"         );
+  rc.numOpennessGradientColors = getiConstant( "numOpennessGradientColors" );
+  rc.influenceHeatMapRepeat    = getiConstant( "influenceHeatMapRepeat"    );
+  rc.influenceHeatMapBlendMode = getiConstant( "influenceHeatMapBlendMode" );
+  rc.renderThreads             = getiConstant( "renderThreads"             );
+
+  // like the output options, the profile comes whole
+  // from whichever output.txt is in effect
+  if( configUserLocal.outputConfigPresent )
+  {
+    rc.pngProfile = configUserLocal.pngProfile;
+  } else if( configUserGlobal.outputConfigPresent ) {
+    rc.pngProfile = configUserGlobal.pngProfile;
+  } else {
+    rc.pngProfile = configInternal.pngProfile;
+  }
+  rc.pngProfile.threads = getiConstant( "encodeThreads" );
+
+  rc.terrainElev1   = Color( getColor( "terrainElev1"   ) );
+  rc.terrainElev3   = Color( getColor( "terrainElev3"   ) );
+  rc.pathingClear   = Color( getColor( "pathingClear"   ) );
+  rc.pathingBlocked = Color( getColor( "pathingBlocked" ) );
+  rc.influence1     = Color( getColor( "influence1"     ) );
+  rc.influence2     = Color( getColor( "influence2"     ) );
+
+  if( rc.influenceHeatMapBlendMode == 2 )
+  {
+    rc.influence3 = Color( getColor( "influence3" ) );
+  } else {
+    rc.influence3 = Color( 0.0f, 0.0f, 0.0f );
+  }
+}
+
+
 int SC2Map::getiConstant( string name )
 {
   // first check local user config
@@ -8,6 +8,7 @@
 using namespace std;
 
 #include "sc2mapTypes.hpp"
+#include "PngEncoder.hpp"
 
 
 struct Config
@@ -23,6 +24,7 @@ struct Config
   bool        outputConfigPresent;
   string      outputPath;
   set<string> outputOptions;
+  PngProfile  pngProfile;
 
 
   map<string, int>    iConstants;
@@ -38,6 +40,51 @@ struct Config
 };
 
 
+// the effective value of every constant and color the
+// analysis and rendering loops need, looked up once per
+// map through the local, global and internal configs so
+// the loops read plain members instead of doing string
+// lookups in three maps for every cell
+struct ResolvedConfig
+{
+  // analysis
+  float defaultMineralAmount;
+  float defaultGeyserAmount;
+  float baseAvgOpennessNeighborhoodRadius;
+  float minInfluenceToConsiderNatOrThird;
+  float chokeDetectionThreshold;
+  float chokeDetectionAgreement;
+  float spaceInMainChokeRadius;
+  float inMainBaseRadius;
+  float territoryContestedMargin;
+  float symmetryTolerance;
+  float influenceWeightGround;
+  float influenceWeightCWalk;
+  float influenceWeightAir;
+
+  // rendering
+  float opennessRenderMax;
+  int   numOpennessGradientColors;
+  int   influenceHeatMapRepeat;
+  int   influenceHeatMapBlendMode;
+  int   renderThreads;
+
+  PngProfile pngProfile;
+
+  Color terrainElev1;
+  Color terrainElev3;
+  Color pathingClear;
+  Color pathingBlocked;
+  Color influence1;
+  Color influence2;
+
+  // there is no internal default for this one, it is
+  // only looked up when the blend mode that uses it is
+  // on, otherwise it is black
+  Color influence3;
+};
+
+
 void initConfigReading();
 
 void readConfigFiles( bool global, string* path, Config* c );
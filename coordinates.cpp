@@ -24,54 +24,54 @@ void point::set( point* p )
   ix  = p->ix;  iy  = p->iy;
 }
 
-void point::mSet( float mxIn, float myIn )
+void point::mSet( const CoordFrame* f, float mxIn, float myIn )
 {
-  mx  = mxIn;           my  = myIn;
-  mtx = m2mt  ( mxIn ); mty = m2mt  ( myIn );
-  mcx = m2mc  ( mxIn ); mcy = m2mc  ( myIn );
-  ptx = mx2ptx( mxIn ); pty = my2pty( myIn );
-  pcx = mx2pcx( mxIn ); pcy = my2pcy( myIn );
-  ix  = mx2ix ( mxIn ); iy  = my2iy ( myIn );
+  mx  = mxIn;              my  = myIn;
+  mtx = m2mt  ( mxIn );    mty = m2mt  ( myIn );
+  mcx = m2mc  ( mxIn );    mcy = m2mc  ( myIn );
+  ptx = mx2ptx( f, mxIn ); pty = my2pty( f, myIn );
+  pcx = mx2pcx( f, mxIn ); pcy = my2pcy( f, myIn );
+  ix  = mx2ix ( f, mxIn ); iy  = my2iy ( f, myIn );
 }
 
-void point::mtSet( int mtxIn, int mtyIn )
+void point::mtSet( const CoordFrame* f, int mtxIn, int mtyIn )
 {
-  mx  = mt2m   ( mtxIn ); my  = mt2m   ( mtyIn );
-  mtx = mtxIn;            mty = mtyIn;
-  mcx = mcNaN;            mcy = mcNaN;
-  ptx = mtx2ptx( mtxIn ); pty = mty2pty( mtyIn );
-  pcx = pcNaN;            pcy = pcNaN;
-  ix  = mtx2ix ( mtxIn ); iy  = mty2iy ( mtyIn );
+  mx  = mt2m   ( mtxIn );    my  = mt2m   ( mtyIn );
+  mtx = mtxIn;               mty = mtyIn;
+  mcx = mcNaN;               mcy = mcNaN;
+  ptx = mtx2ptx( f, mtxIn ); pty = mty2pty( f, mtyIn );
+  pcx = pcNaN;               pcy = pcNaN;
+  ix  = mtx2ix ( f, mtxIn ); iy  = mty2iy ( f, mtyIn );
 }
 
-void point::mcSet( int mcxIn, int mcyIn )
+void point::mcSet( const CoordFrame* f, int mcxIn, int mcyIn )
 {
-  mx  = mc2m   ( mcxIn ); my  = mc2m   ( mcyIn );
-  mtx = mtNaN;            mty = mtNaN;
-  mcx = mcxIn;            mcy = mcyIn;
-  ptx = ptNaN;            pty = ptNaN;
-  pcx = mcx2pcx( mcxIn ); pcy = mcy2pcy( mcyIn );
-  ix  = mcx2ix ( mcxIn ); iy  = mcy2iy ( mcyIn );
+  mx  = mc2m   ( mcxIn );    my  = mc2m   ( mcyIn );
+  mtx = mtNaN;               mty = mtNaN;
+  mcx = mcxIn;               mcy = mcyIn;
+  ptx = ptNaN;               pty = ptNaN;
+  pcx = mcx2pcx( f, mcxIn ); pcy = mcy2pcy( f, mcyIn );
+  ix  = mcx2ix ( f, mcxIn ); iy  = mcy2iy ( f, mcyIn );
 }
 
-void point::ptSet( int ptxIn, int ptyIn )
+void point::ptSet( const CoordFrame* f, int ptxIn, int ptyIn )
 {
-  mx  = ptx2mx ( ptxIn ); my  = pty2my ( ptyIn );
-  mtx = ptx2mtx( ptxIn ); mty = pty2mty( ptyIn );
-  mcx = mcNaN;            mcy = mcNaN;
-  ptx = ptxIn;            pty = ptyIn;
-  pcx = pcNaN;            pcy = pcNaN;
-  ix  = ptx2ix ( ptxIn ); iy  = pty2iy ( ptyIn );
+  mx  = ptx2mx ( f, ptxIn ); my  = pty2my ( f, ptyIn );
+  mtx = ptx2mtx( f, ptxIn ); mty = pty2mty( f, ptyIn );
+  mcx = mcNaN;               mcy = mcNaN;
+  ptx = ptxIn;               pty = ptyIn;
+  pcx = pcNaN;               pcy = pcNaN;
+  ix  = ptx2ix ( f, ptxIn ); iy  = pty2iy ( f, ptyIn );
 }
 
-void point::pcSet( int pcxIn, int pcyIn )
+void point::pcSet( const CoordFrame* f, int pcxIn, int pcyIn )
 {
-  mx  = pcx2mx ( pcxIn ); my  = pty2my ( pcyIn );
-  mtx = mtNaN;            mty = mtNaN;
-  mcx = pcx2mcx( pcxIn ); mcy = pcy2mcy( pcyIn );
-  ptx = ptNaN;            pty = ptNaN;
-  pcx = pcxIn;            pcy = pcyIn;
-  ix  = pcx2ix ( pcxIn ); iy  = pcy2iy ( pcyIn );
+  mx  = pcx2mx ( f, pcxIn ); my  = pty2my ( f, pcyIn );
+  mtx = mtNaN;               mty = mtNaN;
+  mcx = pcx2mcx( f, pcxIn ); mcy = pcy2mcy( f, pcyIn );
+  ptx = ptNaN;               pty = ptNaN;
+  pcx = pcxIn;               pcy = pcyIn;
+  ix  = pcx2ix ( f, pcxIn ); iy  = pcy2iy ( f, pcyIn );
 }
 
 // never a need to translate back from image frame!
@@ -86,20 +86,15 @@ void point::iSet( int ixIn, int iyIn )
 }
 
 
-// translation constants
-int point::mcLeft;
-int point::mcBottom;
-int point::iDimT;
-int point::iDimC;
-
-float point::mcLeftf;
-float point::mcBottomf;
-float point::iDimTf;
+CoordFrame::CoordFrame()
+{
+  set( 0, 0, 0, 0 );
+}
 
-void point::setFrameTranslationConstants( int mcLeftIn,
-                                          int mcBottomIn,
-                                          int iDimTIn,
-                                          int iDimCIn )
+void CoordFrame::set( int mcLeftIn,
+                      int mcBottomIn,
+                      int iDimTIn,
+                      int iDimCIn )
 {
   mcLeft   = mcLeftIn;
   mcBottom = mcBottomIn;
@@ -155,84 +150,84 @@ float point::mc2m( int mc )
 // are simple translations by the constants, with
 // maybe a call to the above core conversions.
 
-int point::mtx2ptx( int mtx )
+int point::mtx2ptx( const CoordFrame* f, int mtx )
 {
-  return mtx - mcLeft;
+  return mtx - f->mcLeft;
 }
 
-int point::mty2pty( int mty )
+int point::mty2pty( const CoordFrame* f, int mty )
 {
-  return mty - mcBottom;
+  return mty - f->mcBottom;
 }
 
-int point::ptx2mtx( int ptx )
+int point::ptx2mtx( const CoordFrame* f, int ptx )
 {
-  return ptx + mcLeft;
+  return ptx + f->mcLeft;
 }
 
-int point::pty2mty( int pty )
+int point::pty2mty( const CoordFrame* f, int pty )
 {
-  return pty + mcBottom;
+  return pty + f->mcBottom;
 }
 
-int point::mcx2pcx( int mcx )
+int point::mcx2pcx( const CoordFrame* f, int mcx )
 {
-  return mcx - mcLeft;
+  return mcx - f->mcLeft;
 }
 
-int point::mcy2pcy( int mcy )
+int point::mcy2pcy( const CoordFrame* f, int mcy )
 {
-  return mcy - mcBottom;
+  return mcy - f->mcBottom;
 }
 
-int point::pcx2mcx( int pcx )
+int point::pcx2mcx( const CoordFrame* f, int pcx )
 {
-  return pcx + mcLeft;
+  return pcx + f->mcLeft;
 }
 
-int point::pcy2mcy( int pcy )
+int point::pcy2mcy( const CoordFrame* f, int pcy )
 {
-  return pcy + mcBottom;
+  return pcy + f->mcBottom;
 }
 
-int point::mx2ptx( float mx )
+int point::mx2ptx( const CoordFrame* f, float mx )
 {
-  return mtx2ptx( m2mt( mx ) );
+  return mtx2ptx( f, m2mt( mx ) );
 }
 
-int point::my2pty( float my )
+int point::my2pty( const CoordFrame* f, float my )
 {
-  return mty2pty( m2mt( my ) );
+  return mty2pty( f, m2mt( my ) );
 }
 
-float point::ptx2mx( int ptx )
+float point::ptx2mx( const CoordFrame* f, int ptx )
 {
-  return mt2m( ptx2mtx( ptx ) );
+  return mt2m( ptx2mtx( f, ptx ) );
 }
 
-float point::pty2my( int pty )
+float point::pty2my( const CoordFrame* f, int pty )
 {
-  return mt2m( pty2mty( pty ) );
+  return mt2m( pty2mty( f, pty ) );
 }
 
-int point::mx2pcx( float mx )
+int point::mx2pcx( const CoordFrame* f, float mx )
 {
-  return mcx2pcx( m2mc( mx ) );
+  return mcx2pcx( f, m2mc( mx ) );
 }
 
-int point::my2pcy( float my )
+int point::my2pcy( const CoordFrame* f, float my )
 {
-  return mcy2pcy( m2mc( my ) );
+  return mcy2pcy( f, m2mc( my ) );
 }
 
-float point::pcx2mx( int pcx )
+float point::pcx2mx( const CoordFrame* f, int pcx )
 {
-  return mc2m( pcx2mcx( pcx ) );
+  return mc2m( pcx2mcx( f, pcx ) );
 }
 
-float point::pcy2my( int pcy )
+float point::pcy2my( const CoordFrame* f, int pcy )
 {
-  return mc2m( pcy2mcy( pcy ) );
+  return mc2m( pcy2mcy( f, pcy ) );
 }
 
 // when translating to the image frame,
@@ -240,52 +235,52 @@ float point::pcy2my( int pcy )
 // appropriate area of a terrain or cell
 // coordinate, and for a general map
 // coordinate just give the closest pixel
-int point::mx2ix( float mx )
+int point::mx2ix( const CoordFrame* f, float mx )
 {
-  return (int)(iDimTf*(mx - mcLeftf));
+  return (int)(f->iDimTf*(mx - f->mcLeftf));
 }
 
-int point::my2iy( float my )
+int point::my2iy( const CoordFrame* f, float my )
 {
-  return (int)(iDimTf*(my - mcBottomf));
+  return (int)(f->iDimTf*(my - f->mcBottomf));
 }
 
-int point::mtx2ix( int mtx )
+int point::mtx2ix( const CoordFrame* f, int mtx )
 {
-  return iDimT*mtx2ptx( mtx );
+  return f->iDimT*mtx2ptx( f, mtx );
 }
 
-int point::mty2iy( int mty )
+int point::mty2iy( const CoordFrame* f, int mty )
 {
-  return iDimT*mty2pty( mty );
+  return f->iDimT*mty2pty( f, mty );
 }
 
-int point::mcx2ix( int mcx )
+int point::mcx2ix( const CoordFrame* f, int mcx )
 {
-  return iDimT*mcx2pcx( mcx ) + iDimT/2;
+  return f->iDimT*mcx2pcx( f, mcx ) + f->iDimT/2;
 }
 
-int point::mcy2iy( int mcy )
+int point::mcy2iy( const CoordFrame* f, int mcy )
 {
-  return iDimT*mcy2pcy( mcy ) + iDimT/2;
+  return f->iDimT*mcy2pcy( f, mcy ) + f->iDimT/2;
 }
 
-int point::ptx2ix( int ptx )
+int point::ptx2ix( const CoordFrame* f, int ptx )
 {
-  return iDimT*ptx;
+  return f->iDimT*ptx;
 }
 
-int point::pty2iy( int pty )
+int point::pty2iy( const CoordFrame* f, int pty )
 {
-  return iDimT*pty;
+  return f->iDimT*pty;
 }
 
-int point::pcx2ix( int pcx )
+int point::pcx2ix( const CoordFrame* f, int pcx )
 {
-  return iDimT*pcx + iDimT/2;
+  return f->iDimT*pcx + f->iDimT/2;
 }
 
-int point::pcy2iy( int pcy )
+int point::pcy2iy( const CoordFrame* f, int pcy )
 {
-  return iDimT*pcy + iDimT/2;
+  return f->iDimT*pcy + f->iDimT/2;
 }
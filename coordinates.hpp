@@ -121,6 +121,31 @@
 //////////////////////////////////////////////////////////////
 
 
+// the translation constants between the frames, they come
+// from the map's playable boundaries so every map has its
+// own and every point is set through the frame of its map,
+// maps analyzed at the same time never share one
+struct CoordFrame
+{
+  CoordFrame();
+
+  void set( int mcLeftIn,
+            int mcBottomIn,
+            int iDimTIn,
+            int iDimCIn );
+
+  int mcLeft;
+  int mcBottom;
+  int iDimT;
+  int iDimC;
+
+  // just convenient casts of above constants
+  float mcLeftf;
+  float mcBottomf;
+  float iDimTf;
+};
+
+
 struct point
 {
   // Not a Number constants for invalid conversions
@@ -130,43 +155,27 @@ struct point
   static const int   ptNaN;
   static const int   pcNaN;
 
-  // frame translation constants
-  static int mcLeft;
-  static int mcBottom;
-  static int iDimT;
-  static int iDimC;
-
-  // just convenient casts of above constants
-  static float mcLeftf;
-  static float mcBottomf;
-  static float iDimTf;
-
-  static void setFrameTranslationConstants( int mcLeftIn,
-                                            int mcBottomIn,
-                                            int iDimTIn,
-                                            int iDimCIn );
-
   void set( point* p );
 
   float mx;
   float my;
-  void mSet( float mxIn, float myIn );
+  void mSet( const CoordFrame* f, float mxIn, float myIn );
 
   int mtx;
   int mty;
-  void mtSet( int mtxIn, int mtyIn );
+  void mtSet( const CoordFrame* f, int mtxIn, int mtyIn );
 
   int mcx;
   int mcy;
-  void mcSet( int mcxIn, int mcyIn );
+  void mcSet( const CoordFrame* f, int mcxIn, int mcyIn );
 
   int ptx;
   int pty;
-  void ptSet( int ptxIn, int ptyIn );
+  void ptSet( const CoordFrame* f, int ptxIn, int ptyIn );
 
   int pcx;
   int pcy;
-  void pcSet( int pcxIn, int pcyIn );
+  void pcSet( const CoordFrame* f, int pcxIn, int pcyIn );
 
   int ix;
   int iy;
@@ -179,44 +188,71 @@ private:
   // defined by Blizzard can be converted
   // between without any x- or y-coordinate
   // specific constants
-  inline int   m2mt ( float m  );
-  inline int   m2mc ( float m  );
-  inline float mt2m ( int   mt );
-  inline float mc2m ( int   mc );
+  static inline int   m2mt ( float m  );
+  static inline int   m2mc ( float m  );
+  static inline float mt2m ( int   mt );
+  static inline float mc2m ( int   mc );
 
   // break the rest of the conversion up
   // into x and y
-  inline int mtx2ptx( int mtx );
-  inline int mty2pty( int mty );
-  inline int ptx2mtx( int ptx );
-  inline int pty2mty( int pty );
-
-  inline int mcx2pcx( int mcx );
-  inline int mcy2pcy( int mcy );
-  inline int pcx2mcx( int pcx );
-  inline int pcy2mcy( int pcy );
-
-  inline int   mx2ptx( float mx  );
-  inline int   my2pty( float my  );
-  inline float ptx2mx( int   ptx );
-  inline float pty2my( int   pty );
-  inline int   mx2pcx( float mx  );
-  inline int   my2pcy( float my  );
-  inline float pcx2mx( int   pcx );
-  inline float pcy2my( int   pcy );
+  static inline int mtx2ptx( const CoordFrame* f, int mtx );
+  static inline int mty2pty( const CoordFrame* f, int mty );
+  static inline int ptx2mtx( const CoordFrame* f, int ptx );
+  static inline int pty2mty( const CoordFrame* f, int pty );
+
+  static inline int mcx2pcx( const CoordFrame* f, int mcx );
+  static inline int mcy2pcy( const CoordFrame* f, int mcy );
+  static inline int pcx2mcx( const CoordFrame* f, int pcx );
+  static inline int pcy2mcy( const CoordFrame* f, int pcy );
+
+  static inline int   mx2ptx( const CoordFrame* f, float mx  );
+  static inline int   my2pty( const CoordFrame* f, float my  );
+  static inline float ptx2mx( const CoordFrame* f, int   ptx );
+  static inline float pty2my( const CoordFrame* f, int   pty );
+  static inline int   mx2pcx( const CoordFrame* f, float mx  );
+  static inline int   my2pcy( const CoordFrame* f, float my  );
+  static inline float pcx2mx( const CoordFrame* f, int   pcx );
+  static inline float pcy2my( const CoordFrame* f, int   pcy );
 
   // no need to ever translate back
   // from image coordinates
-  inline int mx2ix ( float mx  );
-  inline int my2iy ( float my  );
-  inline int mtx2ix( int   mtx );
-  inline int mty2iy( int   mty );
-  inline int mcx2ix( int   mcx );
-  inline int mcy2iy( int   mcy );
-  inline int ptx2ix( int   ptx );
-  inline int pty2iy( int   pty );
-  inline int pcx2ix( int   pcx );
-  inline int pcy2iy( int   pcy );
+  static inline int mx2ix ( const CoordFrame* f, float mx  );
+  static inline int my2iy ( const CoordFrame* f, float my  );
+  static inline int mtx2ix( const CoordFrame* f, int   mtx );
+  static inline int mty2iy( const CoordFrame* f, int   mty );
+  static inline int mcx2ix( const CoordFrame* f, int   mcx );
+  static inline int mcy2iy( const CoordFrame* f, int   mcy );
+  static inline int ptx2ix( const CoordFrame* f, int   ptx );
+  static inline int pty2iy( const CoordFrame* f, int   pty );
+  static inline int pcx2ix( const CoordFrame* f, int   pcx );
+  static inline int pcy2iy( const CoordFrame* f, int   pcy );
+};
+
+
+
+// a point converts into every frame the moment it is set,
+// which is a waste in loops that visit every cell of the
+// map and only ever index the analysis layers.  A cell is
+// just the playable cell frame coordinates packed into two
+// shorts, cheap to make and pass by value; turn it into a
+// point only when another frame is really needed
+struct cell
+{
+  short pcx;
+  short pcy;
+
+  cell() {}
+
+  cell( int pcxIn, int pcyIn )
+  {
+    pcx = (short)pcxIn;
+    pcy = (short)pcyIn;
+  }
+
+  inline void toPoint( const CoordFrame* f, point* p )
+  {
+    p->pcSet( f, pcx, pcy );
+  }
 };
 
 
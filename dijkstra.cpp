@@ -50,13 +50,13 @@ float SC2Map::neighborWeights[] =
 // paths when other code requests an answer
 void SC2Map::prepShortestPaths()
 {
-  // there are a graph of path nodes for every path type
-  mapPathNodes = new Node*[txDimPlayable*
-                           tyDimPlayable*
-                           NUM_PATH_TYPES];
-
+  // there are a graph of path nodes for every path type,
+  // the border is wide enough that the knight's jump
+  // neighbors of an edge cell are simply NULL
   for( int t = 0; t < NUM_PATH_TYPES; ++t )
   {
+    mapPathNodes[t].resize( cxDimPlayable, cyDimPlayable, 2, NULL );
+
     buildPathGraph( (PathType)t );
   }
 }
@@ -64,14 +64,7 @@ void SC2Map::prepShortestPaths()
 
 void SC2Map::setPathNode( point* c, PathType t, Node* u )
 {
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d).\n",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  mapPathNodes[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t] = u;
+  mapPathNodes[t].set( c->pcx, c->pcy, u );
 }
 
 
@@ -85,31 +78,31 @@ Node* SC2Map::getPathNode( point* c, PathType t )
     return NULL;
   }
 
-  return mapPathNodes[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t];
+  return mapPathNodes[t].at( c->pcx, c->pcy );
 }
 
 
 
 void SC2Map::buildPathGraph( PathType t )
 {
+  Grid<Node*>* nodeGrid = &(mapPathNodes[t]);
+
   // first create a node for every pathable cell
-  // for the given pathing type
+  // for the given pathing type, only the nodes
+  // need a full point for their location
   for( int pci = 0; pci < cxDimPlayable; ++pci )
   {
     for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
     {
-      point c;
-      c.pcSet( pci, pcj );
-
       Node* u = NULL;
 
-      if( getPathing( &c, t ) )
+      if( mapPathing[t].get( pci, pcj ) )
       {
-        u = new Node();
+        u = arena.make<Node>();
 
         u->pathsFromThisSrcCalculated = false;
 
-        u->loc.pcSet( pci, pcj );
+        u->loc.pcSet( &frame, pci, pcj );
 
         for( int i = 0; i < NUM_NODE_NEIGHBORS; ++i )
         {
@@ -120,7 +113,7 @@ void SC2Map::buildPathGraph( PathType t )
         this->nodes[t].push_back( u );
       }
 
-      setPathNode( &c, t, u );
+      nodeGrid->at( pci, pcj ) = u;
     }
   }
 
@@ -131,21 +124,9 @@ void SC2Map::buildPathGraph( PathType t )
   {
     for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
     {
-      // useful points for the following neighbor
-      // calculations and tests--all in cell coordinates
-      point c_p0_p0; c_p0_p0.pcSet( pci + 0, pcj + 0 );
-      point c_p0_p1; c_p0_p1.pcSet( pci + 0, pcj + 1 );
-      point c_p1_p2; c_p1_p2.pcSet( pci + 1, pcj + 2 );
-      point c_p1_p1; c_p1_p1.pcSet( pci + 1, pcj + 1 );
-      point c_p2_p1; c_p2_p1.pcSet( pci + 2, pcj + 1 );
-      point c_p1_p0; c_p1_p0.pcSet( pci + 1, pcj + 0 );
-      point c_p2_m1; c_p2_m1.pcSet( pci + 2, pcj - 1 );
-      point c_p1_m1; c_p1_m1.pcSet( pci + 1, pcj - 1 );
-      point c_p1_m2; c_p1_m2.pcSet( pci + 1, pcj - 2 );
-      point c_p0_m1; c_p0_m1.pcSet( pci + 0, pcj - 1 );
-
-
-      Node* u = getPathNode( &c_p0_p0, t );
+      // the grid's border means these unchecked
+      // reads are NULL off the edge of the map
+      Node* u = nodeGrid->at( pci, pcj );
       if( u == NULL ) { continue; }
 
       // we only have to link to half of u's possible
@@ -154,14 +135,14 @@ void SC2Map::buildPathGraph( PathType t )
       Node* v;
 
       // for adjacent cells, if it is there its connected
-      v = getPathNode( &c_p0_p1, t );
+      v = nodeGrid->at( pci + 0, pcj + 1 );
       if( v != NULL )
       {
         u->neighbors[0] = v;
         v->neighbors[2] = u;
       }
 
-      v = getPathNode( &c_p1_p0, t );
+      v = nodeGrid->at( pci + 1, pcj + 0 );
       if( v != NULL )
       {
         u->neighbors[1] = v;
@@ -175,22 +156,22 @@ void SC2Map::buildPathGraph( PathType t )
       // PATHING AND IN SOME CASES A TRUE PATH IS ONLY CONNECTED
       // TO ANOTHER CELL BY A DIAGONAL NEIGHBOR, SO FOR NOW IT'S
       // IF DIAG NEIGHBOR EXISTS --> IT'S PATHABLE
-      v = getPathNode( &c_p1_p1, t );
+      v = nodeGrid->at( pci + 1, pcj + 1 );
       if( v != NULL )
       {
-        //if( getPathNode( &c_p0_p1, t ) != NULL ||
-        //    getPathNode( &c_p1_p0, t ) != NULL
+        //if( nodeGrid->at( pci + 0, pcj + 1 ) != NULL ||
+        //    nodeGrid->at( pci + 1, pcj + 0 ) != NULL
         //  ) {
           u->neighbors[4] = v;
           v->neighbors[6] = u;
         //}
       }
 
-      v = getPathNode( &c_p1_m1, t );
+      v = nodeGrid->at( pci + 1, pcj - 1 );
       if( v != NULL )
       {
-        //if( getPathNode( &c_p0_m1, t ) != NULL ||
-        //    getPathNode( &c_p1_p0, t ) != NULL
+        //if( nodeGrid->at( pci + 0, pcj - 1 ) != NULL ||
+        //    nodeGrid->at( pci + 1, pcj + 0 ) != NULL
         //  ) {
           u->neighbors[5] = v;
           v->neighbors[7] = u;
@@ -201,44 +182,44 @@ void SC2Map::buildPathGraph( PathType t )
       // cells in between are pathable, it suffices:
       //    P v   <-- if P cells are pathable, make
       //  u P         the link u<-->v
-      v = getPathNode( &c_p1_p2, t );
+      v = nodeGrid->at( pci + 1, pcj + 2 );
       if( v != NULL )
       {
-        if( getPathNode( &c_p0_p1, t ) != NULL &&
-            getPathNode( &c_p1_p1, t ) != NULL
+        if( nodeGrid->at( pci + 0, pcj + 1 ) != NULL &&
+            nodeGrid->at( pci + 1, pcj + 1 ) != NULL
           ) {
           u->neighbors[8]  = v;
           v->neighbors[12] = u;
         }
       }
 
-      v = getPathNode( &c_p2_p1, t );
+      v = nodeGrid->at( pci + 2, pcj + 1 );
       if( v != NULL )
       {
-        if( getPathNode( &c_p1_p0, t ) != NULL &&
-            getPathNode( &c_p1_p1, t ) != NULL
+        if( nodeGrid->at( pci + 1, pcj + 0 ) != NULL &&
+            nodeGrid->at( pci + 1, pcj + 1 ) != NULL
           ) {
           u->neighbors[9]  = v;
           v->neighbors[13] = u;
         }
       }
 
-      v = getPathNode( &c_p2_m1, t );
+      v = nodeGrid->at( pci + 2, pcj - 1 );
       if( v != NULL )
       {
-        if( getPathNode( &c_p1_p0, t ) != NULL &&
-            getPathNode( &c_p1_m1, t ) != NULL
+        if( nodeGrid->at( pci + 1, pcj + 0 ) != NULL &&
+            nodeGrid->at( pci + 1, pcj - 1 ) != NULL
           ) {
           u->neighbors[10] = v;
           v->neighbors[14] = u;
         }
       }
 
-      v = getPathNode( &c_p1_m2, t );
+      v = nodeGrid->at( pci + 1, pcj - 2 );
       if( v != NULL )
       {
-        if( getPathNode( &c_p0_m1, t ) != NULL &&
-            getPathNode( &c_p1_m1, t ) != NULL
+        if( nodeGrid->at( pci + 0, pcj - 1 ) != NULL &&
+            nodeGrid->at( pci + 1, pcj - 1 ) != NULL
           ) {
           u->neighbors[11] = v;
           v->neighbors[15] = u;
@@ -275,18 +256,21 @@ float SC2Map::getShortestPathDistance( Node* u, Node* v, PathType t )
     return 0.0f;
   }
 
-  if( !(u->pathsFromThisSrcCalculated) )
+  // nodes in different components can never reach one
+  // another, don't bother running a search to learn that
+  if( getComponent( &(u->loc), t ) != getComponent( &(v->loc), t ) )
   {
-    computeShortestPaths( u, t );
-    u->pathsFromThisSrcCalculated = true;
+    return infinity;
   }
-  return (*(d[t][u->id]))[v->id];
+
+  requireShortestPaths( u, t );
+  return d[t][u->id][v->id];
 }
 
 
 void SC2Map::setShortestPathDistance( Node* u, Node* v, PathType t, float dIn )
 {
-  (*(d[t][u->id]))[v->id] = dIn;
+  d[t][u->id][v->id] = dIn;
 }
 
 
@@ -297,29 +281,41 @@ Node* SC2Map::getShortestPathPredecessor( Node* u, Node* v, PathType t )
     return NULL;
   }
 
-  if( !(u->pathsFromThisSrcCalculated) )
+  if( getComponent( &(u->loc), t ) != getComponent( &(v->loc), t ) )
   {
-    computeShortestPaths( u, t );
-    u->pathsFromThisSrcCalculated = true;
+    return NULL;
   }
-  return (*(pi[t][u->id]))[v->id];
+
+  requireShortestPaths( u, t );
+  return pi[t][u->id][v->id];
 }
 
 
 void SC2Map::setShortestPathPredecessor( Node* u, Node* v, PathType t, Node* piIn )
 {
-  (*(pi[t][u->id]))[v->id] = piIn;
+  pi[t][u->id][v->id] = piIn;
 }
 
 
-void SC2Map::computeShortestPaths( Node* src, PathType t )
+void SC2Map::requireShortestPaths( Node* src, PathType t )
 {
-  // add entries to the shortest path hashmaps for this source
-  vector<float>*  dEntry = new vector<float>();
-  vector<Node*>* piEntry = new vector<Node*>();
+  if( !(src->pathsFromThisSrcCalculated) )
+  {
+    if( !deriveShortestPaths( src, t ) )
+    {
+      computeShortestPaths( src, t );
+    }
+    src->pathsFromThisSrcCalculated = true;
+  }
+}
+
 
-   dEntry->resize( nodes[t].size() );
-  piEntry->resize( nodes[t].size() );
+void SC2Map::computeShortestPaths( Node* src, PathType t )
+{
+  // add entries to the shortest path hashmaps for this source,
+  // every slot of both is filled in by the search below
+  float*  dEntry = arena.makeArray<float>( nodes[t].size() );
+  Node** piEntry = arena.makeArray<Node*>( nodes[t].size() );
 
   d [t].insert( make_pair( src->id,  dEntry ) );
   pi[t].insert( make_pair( src->id, piEntry ) );
@@ -403,20 +399,21 @@ float SC2Map::getShortestPathDistance( point* p, Base* b, PathType t )
 
 float SC2Map::getShortestPathDistance( Node* u, Base* b, PathType t )
 {
-  if( !(u->pathsFromThisSrcCalculated) )
-  {
-    computeShortestPaths( u, t );
-    u->pathsFromThisSrcCalculated = true;
-  }
+  // shortest paths from u are only computed if some
+  // patch node of the base is in u's component
+  int label = getComponent( &(u->loc), t );
 
   float dShortest = infinity;
 
-  for( map<Node*, float>::iterator itr = (b->node2patchDistance[t]).begin();
-       itr != (b->node2patchDistance[t]).end();
-       ++itr )
+  PatchNodes* patches = &(b->node2patchDistance[t]);
+
+  for( int i = 0; i < patches->count; ++i )
   {
-    Node* v      = itr->first;
-    float dPatch = itr->second;
+    Node* v      = nodes[t][patches->entries[i].id];
+    float dPatch = patches->entries[i].d;
+
+    if( getComponent( &(v->loc), t ) != label ) { continue; }
+
     float dRoute = getShortestPathDistance( u, v, t );
 
     if( dPatch + dRoute < dShortest )
@@ -433,20 +430,19 @@ float SC2Map::getShortestPathDistance( Base* b1, Base* b2, PathType t )
 {
   float dShortest = infinity;
 
-  for( map<Node*, float>::iterator itr1 = (b1->node2patchDistance[t]).begin();
-       itr1 != (b1->node2patchDistance[t]).end();
-       ++itr1 )
+  PatchNodes* patches1 = &(b1->node2patchDistance[t]);
+  PatchNodes* patches2 = &(b2->node2patchDistance[t]);
+
+  for( int i = 0; i < patches1->count; ++i )
   {
-    Node* u       = itr1->first;
-    float dPatch1 = itr1->second;
+    Node* u       = nodes[t][patches1->entries[i].id];
+    float dPatch1 = patches1->entries[i].d;
 
 
-    for( map<Node*, float>::iterator itr2 = (b2->node2patchDistance[t]).begin();
-         itr2 != (b2->node2patchDistance[t]).end();
-         ++itr2 )
+    for( int j = 0; j < patches2->count; ++j )
     {
-      Node* v       = itr2->first;
-      float dPatch2 = itr2->second;
+      Node* v       = nodes[t][patches2->entries[j].id];
+      float dPatch2 = patches2->entries[j].d;
 
 
       float dRoute = getShortestPathDistance( u, v, t );
@@ -464,21 +460,22 @@ float SC2Map::getShortestPathDistance( Base* b1, Base* b2, PathType t )
 
 Node* SC2Map::getShortestPathPredecessor( Node* u, Base* b, PathType t )
 {
-  if( !(u->pathsFromThisSrcCalculated) )
-  {
-    computeShortestPaths( u, t );
-    u->pathsFromThisSrcCalculated = true;
-  }
+  // shortest paths from u are only computed if some
+  // patch node of the base is in u's component
+  int label = getComponent( &(u->loc), t );
 
   float dShortest = infinity;
   Node* pred      = NULL;
 
-  for( map<Node*, float>::iterator itr = (b->node2patchDistance[t]).begin();
-       itr != (b->node2patchDistance[t]).end();
-       ++itr )
+  PatchNodes* patches = &(b->node2patchDistance[t]);
+
+  for( int i = 0; i < patches->count; ++i )
   {
-    Node* v      = itr->first;
-    float dPatch = itr->second;
+    Node* v      = nodes[t][patches->entries[i].id];
+    float dPatch = patches->entries[i].d;
+
+    if( getComponent( &(v->loc), t ) != label ) { continue; }
+
     float dRoute = getShortestPathDistance( u, v, t );
 
     if( dPatch + dRoute < dShortest )
@@ -497,20 +494,19 @@ void SC2Map::getShortestPathPredecessors( Base* b0, Base* b1, PathType t,
 {
   float dShortest = infinity;
 
-  for( map<Node*, float>::iterator itr0 = (b0->node2patchDistance[t]).begin();
-       itr0 != (b0->node2patchDistance[t]).end();
-       ++itr0 )
+  PatchNodes* patches0 = &(b0->node2patchDistance[t]);
+  PatchNodes* patches1 = &(b1->node2patchDistance[t]);
+
+  for( int i = 0; i < patches0->count; ++i )
   {
-    Node* u       = itr0->first;
-    float dPatch0 = itr0->second;
+    Node* u       = nodes[t][patches0->entries[i].id];
+    float dPatch0 = patches0->entries[i].d;
 
 
-    for( map<Node*, float>::iterator itr1 = (b1->node2patchDistance[t]).begin();
-         itr1 != (b1->node2patchDistance[t]).end();
-         ++itr1 )
+    for( int j = 0; j < patches1->count; ++j )
     {
-      Node* v       = itr1->first;
-      float dPatch1 = itr1->second;
+      Node* v       = nodes[t][patches1->entries[j].id];
+      float dPatch1 = patches1->entries[j].d;
 
 
       float dRoute = getShortestPathDistance( u, v, t );
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
+#include <math.h>
 
 #include "outstreams.hpp"
 #include "coordinates.hpp"
@@ -18,23 +19,13 @@ float SC2Map::OPENNESS_NOTCALCULATED = -1.0f;
 void SC2Map::computeOpenness()
 {
   // we need the previous pass's openness values
-  // while we are updating the current values
-  mapOpenness     = new float[cxDimPlayable*cyDimPlayable*NUM_PATH_TYPES];
-  mapOpennessPrev = new float[cxDimPlayable*cyDimPlayable*NUM_PATH_TYPES];
-
-  // initialize all cells for all pathing types to not-calculated
-  for( int pci = 0; pci < cxDimPlayable; ++pci )
+  // while we are updating the current values, and
+  // all cells for all pathing types start out
+  // not-calculated
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
   {
-    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
-    {
-      point c;
-      c.pcSet( pci, pcj );
-
-      for( int t = 0; t < NUM_PATH_TYPES; ++t )
-      {
-        setOpenness( &c, (PathType)t, OPENNESS_NOTCALCULATED );
-      }
-    }
+    mapOpenness    [t].resize( cxDimPlayable, cyDimPlayable, 0, OPENNESS_NOTCALCULATED );
+    mapOpennessPrev[t].resize( cxDimPlayable, cyDimPlayable, 0, OPENNESS_NOTCALCULATED );
   }
 
   computeOpenness( PATH_GROUND_WITHROCKS );
@@ -52,30 +43,36 @@ void SC2Map::computeOpenness( PathType t )
   // use to calculate average openness;
   float total = 0.0f;
 
+  Grid<float>* current  = &(mapOpenness    [t]);
+  Grid<float>* lastPass = &(mapOpennessPrev[t]);
+  Grid<Node*>* nodeGrid = &(mapPathNodes   [t]);
+
 
   while( numCellsCalculated < numPathableCells[t] )
   {
-    // to begin, copy current into the last pass
-    memcpy( mapOpennessPrev,
-            mapOpenness,
-            cxDimPlayable*cyDimPlayable*NUM_PATH_TYPES*sizeof( float ) );
+    // to begin, copy current into the last pass, only
+    // this path type's layer changes between passes
+    lastPass->copyFrom( current );
 
-    // consult last pass to calculate current pass
-    for( int pci = 0; pci < cxDimPlayable; ++pci )
+    // consult last pass to calculate current pass, this
+    // visits every cell every pass so stick to cell
+    // indices and the grids' unchecked accessors
+    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
     {
-      for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+      for( int pci = 0; pci < cxDimPlayable; ++pci )
       {
-        point c;
-        c.pcSet( pci, pcj );
+        cell c( pci, pcj );
 
-        // only calculate openness for pathable cells
-        if( !getPathing( &c, t ) )
+        // only calculate openness for pathable cells,
+        // which are exactly the cells with a path node
+        Node* u = nodeGrid->at( c.pcx, c.pcy );
+        if( u == NULL )
         {
           continue;
         }
 
         // only set each cell once!
-        if( checkHasOpennessLastPass( &c, t ) )
+        if( lastPass->at( c.pcx, c.pcy ) > -0.5f )
         {
           continue;
         }
@@ -87,7 +84,6 @@ void SC2Map::computeOpenness( PathType t )
         // it should be set to the lowest of {openness value coming in
         // from a neighbor plus the distance to that neighbor}
 
-        Node* u               = getPathNode( &c, t );
         float opennessCurrent = infinity;
         bool  markNow         = false;
 
@@ -116,11 +112,13 @@ void SC2Map::computeOpenness( PathType t )
             Node* v = u->neighbors[i];
             if( v == NULL ) { continue; }
 
-            if( checkHasOpennessLastPass( &(v->loc), t ) )
+            float opennessLastPass = lastPass->at( v->loc.pcx, v->loc.pcy );
+
+            if( opennessLastPass > -0.5f )
             {
               markNow = true;
 
-              float openness = getOpennessLastPass( &(v->loc), t ) + neighborWeights[i];
+              float openness = opennessLastPass + neighborWeights[i];
               if( openness < opennessCurrent )
               {
                 opennessCurrent = openness;
@@ -131,7 +129,7 @@ void SC2Map::computeOpenness( PathType t )
 
         if( markNow )
         {
-          setOpenness( &c, t, opennessCurrent );
+          current->at( c.pcx, c.pcy ) = opennessCurrent;
 
           total += opennessCurrent;
 
@@ -158,40 +156,19 @@ void SC2Map::computeOpenness( PathType t )
 
 void SC2Map::setOpenness( point* c, PathType t, float o )
 {
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d).\n",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  mapOpenness[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t] = o;
+  mapOpenness[t].set( c->pcx, c->pcy, o );
 }
 
 
 bool SC2Map::checkHasOpenness( point* c, PathType t )
 {
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d)\n.",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  return mapOpenness[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t] > -0.5f;
+  return mapOpenness[t].get( c->pcx, c->pcy ) > -0.5f;
 }
 
 
 float SC2Map::getOpenness( point* c, PathType t )
 {
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d)\n.",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  return mapOpenness[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t];
+  return mapOpenness[t].get( c->pcx, c->pcy );
 }
 
 
@@ -203,20 +180,12 @@ bool SC2Map::checkHasOpennessLastPass( point* c, PathType t )
     return false;
   }
 
-  return
-    mapOpennessPrev[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t] > -0.5f;
+  return mapOpennessPrev[t].at( c->pcx, c->pcy ) > -0.5f;
 }
 
 float SC2Map::getOpennessLastPass( point* c, PathType t )
 {
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d)\n.",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  return mapOpennessPrev[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t];
+  return mapOpennessPrev[t].get( c->pcx, c->pcy );
 }
 
 
@@ -249,7 +218,7 @@ float SC2Map::calculateAverageOpennessInNeighborhood( point*   p,
       ++cellsSampled;
 
       point c;
-      c.pcSet( p->pcx + pci,
+      c.pcSet( &frame, p->pcx + pci,
                p->pcy + pcj );
 
       if( isPlayableCell( &c ) &&
@@ -327,7 +296,7 @@ void SC2Map::locateChokes()
       float dTest  = dTotal;
 
       point pBest;
-      pBest.mSet( -1000.0f + sl2->loc.mx,
+      pBest.mSet( &frame, -1000.0f + sl2->loc.mx,
                   -1000.0f + sl2->loc.my );
 
       float dChokeMin = infinity;
@@ -343,7 +312,7 @@ void SC2Map::locateChokes()
           break;
         }
 
-        if( dChoke < getfConstant( "chokeDetectionThreshold" ) )
+        if( dChoke < rc.chokeDetectionThreshold )
         {
           trippedThreshold = true;
 
@@ -369,7 +338,7 @@ void SC2Map::locateChokes()
          ++itr1 )
     {
       point c1;
-      c1.pcSet( (*itr1).pcx, (*itr1).pcy );
+      c1.pcSet( &frame, (*itr1).pcx, (*itr1).pcy );
 
       list<point>::iterator itr2 = itr1;
       ++itr2;
@@ -378,9 +347,9 @@ void SC2Map::locateChokes()
            ++itr2 )
       {
         point c2;
-        c2.pcSet( (*itr2).pcx, (*itr2).pcy );
+        c2.pcSet( &frame, (*itr2).pcx, (*itr2).pcy );
 
-        if( p2pDistance( &c1, &c2 ) > getfConstant( "chokeDetectionAgreement" ) )
+        if( p2pDistance( &c1, &c2 ) > rc.chokeDetectionAgreement )
         {
           chokesAgree = false;
           break;
@@ -395,12 +364,12 @@ void SC2Map::locateChokes()
     {
       float xAvg = xTotal / (float)possibleChokes.size();
       float yAvg = yTotal / (float)possibleChokes.size();
-      sl1->mainChoke.mSet( xAvg, yAvg );
+      sl1->mainChoke.mSet( &frame, xAvg, yAvg );
 
     } else {
       printWarning( "Could not locate main choke for start location %s.\n",
                     sl1->name );
-      sl1->mainChoke.mSet( -1.0f, -1.0f );
+      sl1->mainChoke.mSet( &frame, -1.0f, -1.0f );
     }
   }
 }
@@ -432,7 +401,7 @@ float SC2Map::spanDistance( point* c, PathType t, int dx, int dy )
   s.set( c );
   while( getPathingOutOfBoundsOK( &s, t ) )
   {
-    s.pcSet( s.pcx + dx, s.pcy + dy );
+    s.pcSet( &frame, s.pcx + dx, s.pcy + dy );
   }
   return p2pDistance( c, &s );
 }
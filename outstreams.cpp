@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <pthread.h>
 
 #include "utility.hpp"
 #include "outstreams.hpp"
@@ -14,6 +15,10 @@ static bool printErrors   = true;
 static int numWarnings = 0;
 static int numErrors   = 0;
 
+// several maps can be analyzed at once, keep each
+// message whole and the counts right
+static pthread_mutex_t outLock = PTHREAD_MUTEX_INITIALIZER;
+
 
 void printOutstreamStatus()
 {
@@ -27,30 +32,43 @@ void printOutstreamStatus()
 void printMessage( const char* format, ... )
 {
   if( !printMessages ) { return; }
+  pthread_mutex_lock( &outLock );
   va_list argptr;
   va_start( argptr, format );
   vfprintf( stdout, format, argptr );
   va_end( argptr );
   fflush( stdout );
   warningOrErrorReported = true;
+  pthread_mutex_unlock( &outLock );
 }
 
 void printWarning( const char* format, ... )
 {
+  pthread_mutex_lock( &outLock );
   ++numWarnings;
-  if( !printWarnings ) { return; }
+  if( !printWarnings )
+  {
+    pthread_mutex_unlock( &outLock );
+    return;
+  }
   fprintf( stderr, "Warning: " );
   va_list argptr;
   va_start( argptr, format );
   vfprintf( stderr, format, argptr );
   va_end( argptr );
   fflush( stderr );
+  pthread_mutex_unlock( &outLock );
 }
 
 void printError( const char* format, ... )
 {
+  pthread_mutex_lock( &outLock );
   ++numErrors;
-  if( !printErrors ) { return; }
+  if( !printErrors )
+  {
+    pthread_mutex_unlock( &outLock );
+    return;
+  }
   fprintf( stderr, "ERROR: " );
   va_list argptr;
   va_start( argptr, format );
@@ -61,6 +79,7 @@ void printError( const char* format, ... )
            adminEmail );
   fflush( stderr );
   warningOrErrorReported = true;
+  pthread_mutex_unlock( &outLock );
 }
 
 void enableMessages() { printMessages = true;  }
@@ -15,7 +15,7 @@
 
 void SC2Map::setMapCliffChange( point* c, bool mcc )
 {
-  mapCliffChanges[(c->mcx/2) + (c->mcy/2)*(cxDimMap/2)] = mcc;
+  mapCliffChanges.at( c->mcx/2, c->mcy/2 ) = mcc;
 }
 
 
@@ -29,7 +29,7 @@ bool SC2Map::getMapCliffChange( point* c )
     return false;
   }
 
-  return mapCliffChanges[(c->mcx/2) + (c->mcy/2)*(cxDimMap/2)];
+  return mapCliffChanges.at( c->mcx/2, c->mcy/2 );
 }
 
 
@@ -41,7 +41,12 @@ void SC2Map::setPathing( point* c, PathType t, bool p )
     // just silently fail, no problem
     return;
   }
-  mapPathing[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t] = p;
+  if( p )
+  {
+    mapPathing[t].set( c->pcx, c->pcy );
+  } else {
+    mapPathing[t].unset( c->pcx, c->pcy );
+  }
 }
 
 
@@ -90,7 +95,7 @@ bool SC2Map::getPathing( point* c, PathType t )
                 c->pcy );
     exit( -1 );
   }
-  return mapPathing[NUM_PATH_TYPES*(c->pcy*cxDimPlayable + c->pcx) + t];
+  return mapPathing[t].get( c->pcx, c->pcy );
 }
 
 
@@ -114,7 +119,10 @@ void SC2Map::computePathingFromCliffChanges()
   }
 
   // the data for analysis only includes the playable area
-  mapPathing = new bool[cxDimPlayable*cyDimPlayable*NUM_PATH_TYPES];
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    mapPathing[t].resize( cxDimPlayable, cyDimPlayable );
+  }
 
   for( int jMapCell = 0; jMapCell < cyDimMap/2; ++jMapCell )
   {
@@ -124,10 +132,10 @@ void SC2Map::computePathingFromCliffChanges()
       point c_p1_p0;
       point c_p0_p1;
       point c_p1_p1;
-      c_p0_p0.mcSet(     2*iMapCell,     2*jMapCell );
-      c_p1_p0.mcSet( 1 + 2*iMapCell,     2*jMapCell );
-      c_p0_p1.mcSet(     2*iMapCell, 1 + 2*jMapCell );
-      c_p1_p1.mcSet( 1 + 2*iMapCell, 1 + 2*jMapCell );
+      c_p0_p0.mcSet( &frame,     2*iMapCell,     2*jMapCell );
+      c_p1_p0.mcSet( &frame, 1 + 2*iMapCell,     2*jMapCell );
+      c_p0_p1.mcSet( &frame,     2*iMapCell, 1 + 2*jMapCell );
+      c_p1_p1.mcSet( &frame, 1 + 2*iMapCell, 1 + 2*jMapCell );
 
 
       // start by allowing all pathing
@@ -136,11 +144,11 @@ void SC2Map::computePathingFromCliffChanges()
       setPathingAllTypes( &c_p0_p1, true );
       setPathingAllTypes( &c_p1_p1, true );
 
-      point t_mid; t_mid.ptSet( c_p1_p1.pcx,     c_p1_p1.pcy     );
-      point t_ur;  t_ur .ptSet( c_p1_p1.pcx + 1, c_p1_p1.pcy + 1 );
-      point t_lr;  t_lr .ptSet( c_p1_p1.pcx + 1, c_p1_p1.pcy - 1 );
-      point t_ll;  t_ll .ptSet( c_p1_p1.pcx - 1, c_p1_p1.pcy - 1 );
-      point t_ul;  t_ul .ptSet( c_p1_p1.pcx - 1, c_p1_p1.pcy + 1 );
+      point t_mid; t_mid.ptSet( &frame, c_p1_p1.pcx,     c_p1_p1.pcy     );
+      point t_ur;  t_ur .ptSet( &frame, c_p1_p1.pcx + 1, c_p1_p1.pcy + 1 );
+      point t_lr;  t_lr .ptSet( &frame, c_p1_p1.pcx + 1, c_p1_p1.pcy - 1 );
+      point t_ll;  t_ll .ptSet( &frame, c_p1_p1.pcx - 1, c_p1_p1.pcy - 1 );
+      point t_ul;  t_ul .ptSet( &frame, c_p1_p1.pcx - 1, c_p1_p1.pcy + 1 );
 
       if( !isPlayableTerrain( &t_mid ) )
       {
@@ -369,16 +377,16 @@ void SC2Map::processRamp( TiXmlElement* ramp )
   // p0 is the "pivot point" that slides along
   // the width of the ramp until we're done
   point p0;
-  p0.mSet( leftLo.mx , leftLo.my );
-  p0.mcSet( p0.mcx + sx, p0.mcy + sy );
+  p0.mSet( &frame, leftLo.mx , leftLo.my );
+  p0.mcSet( &frame, p0.mcx + sx, p0.mcy + sy );
 
   // p1 jumps from p0 to fill out the ramp
   point p1;
 
   // when p0 equals p2, do other ramp edge and end
   point p2;
-  p2.mSet( rightLo.mx , rightLo.my );
-  p2.mcSet( p2.mcx + sx, p2.mcy + sy );
+  p2.mSet( &frame, rightLo.mx , rightLo.my );
+  p2.mcSet( &frame, p2.mcx + sx, p2.mcy + sy );
 
 
   // the straight ramp and diagonal ramp have similar algorithms, but
@@ -389,10 +397,10 @@ void SC2Map::processRamp( TiXmlElement* ramp )
     // straight ramp algorithm
 
     // do the ramp edge
-    p1.pcSet( p0.pcx - vx, p0.pcy - vy );
+    p1.pcSet( &frame, p0.pcx - vx, p0.pcy - vy );
     setPathingNonCliffTypes( &p1, false );
 
-    p1.pcSet( p1.pcx - ux, p1.pcy - uy );
+    p1.pcSet( &frame, p1.pcx - ux, p1.pcy - uy );
     setPathingNonCliffTypes( &p1, false );
 
     while( (p0.pcx != p2.pcx || p0.pcy != p2.pcy) &&
@@ -401,19 +409,19 @@ void SC2Map::processRamp( TiXmlElement* ramp )
       setPathingAllTypes      ( &p0, true  );
       setPathingBuildableTypes( &p0, false );
 
-      p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+      p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
       setPathingAllTypes      ( &p1, true  );
       //setPathingBuildableTypes( &p1, false ); <-- DON'T DO THIS
 
-      p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+      p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
       setPathingAllTypes      ( &p1, true  );
       setPathingBuildableTypes( &p1, false );
 
-      p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+      p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
       setPathingAllTypes      ( &p1, true  );
       setPathingBuildableTypes( &p1, false );
 
-      p0.pcSet( p0.pcx + vx, p0.pcy + vy );
+      p0.pcSet( &frame, p0.pcx + vx, p0.pcy + vy );
 
       --sanityCounter;
     }
@@ -421,7 +429,7 @@ void SC2Map::processRamp( TiXmlElement* ramp )
     // do the ramp edge
     setPathingNonCliffTypes( &p0, false );
 
-    p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+    p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
     setPathingNonCliffTypes( &p1, false );
 
     return;
@@ -431,56 +439,56 @@ void SC2Map::processRamp( TiXmlElement* ramp )
 
 
   // do the ramp edge
-  p1.pcSet( p0.pcx - wx, p0.pcy - wy );
+  p1.pcSet( &frame, p0.pcx - wx, p0.pcy - wy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p1.pcx - ux, p1.pcy - uy );
+  p1.pcSet( &frame, p1.pcx - ux, p1.pcy - uy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - 2*wx, p0.pcy - 2*wy );
+  p1.pcSet( &frame, p0.pcx - 2*wx, p0.pcy - 2*wy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p1.pcx + ux, p1.pcy + uy );
+  p1.pcSet( &frame, p1.pcx + ux, p1.pcy + uy );
   setPathingNonCliffTypes( &p1, false );
 
 
   setPathingAllTypes      ( &p0, true  );
   setPathingBuildableTypes( &p0, false );
 
-  p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+  p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+  p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+  p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p0.pcSet( p0.pcx + wx - ux, p0.pcy + wy - uy );
+  p0.pcSet( &frame, p0.pcx + wx - ux, p0.pcy + wy - uy );
 
   setPathingAllTypes      ( &p0, true  );
   setPathingBuildableTypes( &p0, false );
 
-  p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+  p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx + 2*ux, p0.pcy + 2*uy );
+  p1.pcSet( &frame, p0.pcx + 2*ux, p0.pcy + 2*uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+  p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+  p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p0.pcSet( p0.pcx + wx, p0.pcy + wy );
+  p0.pcSet( &frame, p0.pcx + wx, p0.pcy + wy );
 
 
   while( (p0.pcx != p2.pcx || p0.pcy != p2.pcy) &&
@@ -489,40 +497,40 @@ void SC2Map::processRamp( TiXmlElement* ramp )
     setPathingAllTypes      ( &p0, true  );
     setPathingBuildableTypes( &p0, false );
 
-    p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+    p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+    p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+    p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p0.pcSet( p0.pcx + wx - ux, p0.pcy + wy - uy );
+    p0.pcSet( &frame, p0.pcx + wx - ux, p0.pcy + wy - uy );
 
     setPathingAllTypes      ( &p0, true  );
     setPathingBuildableTypes( &p0, false );
 
-    p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+    p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p1.pcSet( p0.pcx + 2*ux, p0.pcy + 2*uy );
+    p1.pcSet( &frame, p0.pcx + 2*ux, p0.pcy + 2*uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+    p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+    p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
     setPathingAllTypes      ( &p1, true  );
     setPathingBuildableTypes( &p1, false );
 
-    p0.pcSet( p0.pcx + wx, p0.pcy + wy );
+    p0.pcSet( &frame, p0.pcx + wx, p0.pcy + wy );
 
     --sanityCounter;
   }
@@ -538,30 +546,30 @@ void SC2Map::processRamp( TiXmlElement* ramp )
   setPathingAllTypes      ( &p0, true  );
   setPathingBuildableTypes( &p0, false );
 
-  p1.pcSet( p0.pcx + ux, p0.pcy + uy );
+  p1.pcSet( &frame, p0.pcx + ux, p0.pcy + uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+  p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p1.pcSet( p0.pcx - 2*ux, p0.pcy - 2*uy );
+  p1.pcSet( &frame, p0.pcx - 2*ux, p0.pcy - 2*uy );
   setPathingAllTypes      ( &p1, true  );
   setPathingBuildableTypes( &p1, false );
 
-  p0.pcSet( p0.pcx + wx, p0.pcy + wy );
+  p0.pcSet( &frame, p0.pcx + wx, p0.pcy + wy );
 
-  p1.pcSet( p0.pcx - ux, p0.pcy - uy );
+  p1.pcSet( &frame, p0.pcx - ux, p0.pcy - uy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p1.pcx - ux, p1.pcy - uy );
+  p1.pcSet( &frame, p1.pcx - ux, p1.pcy - uy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p1.pcx + wx, p1.pcy + wy );
+  p1.pcSet( &frame, p1.pcx + wx, p1.pcy + wy );
   setPathingNonCliffTypes( &p1, false );
 
-  p1.pcSet( p1.pcx + ux, p1.pcy + uy );
+  p1.pcSet( &frame, p1.pcx + ux, p1.pcy + uy );
   setPathingNonCliffTypes( &p1, false );
 }
 
@@ -583,6 +591,6 @@ point SC2Map::parseRampPoint( const char* str )
   y = snapIfNearInt( y );
 
   point p;
-  p.mSet( x, y );
+  p.mSet( &frame, x, y );
   return p;
 }
@@ -19,20 +19,6 @@ using namespace std;
 
 
 
-struct FootToApply
-{
-  point  loc;
-  float  rot;
-  string type;
-  string name;
-};
-
-
-static list<point>       pathingFills;
-static list<FootToApply> footsToApply;
-
-
-
 void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 {
   char* objPoint;
@@ -150,8 +136,10 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 
     if( strcmp( strType, "StartLoc" ) == 0 )
     {
-      StartLoc* sl = new StartLoc;
-      sl->loc.mSet( mx, my );
+      StartLoc* sl = arena.make<StartLoc>();
+      sl->loc.mSet( &frame, mx, my );
+      sl->index = startLocs.size();
+      sl->symmetricPartner = NULL;
       startLocs.push_back( sl );
       return;
     }
@@ -160,7 +148,7 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
     if( strcmp( strType, "BlockPathing" ) == 0 )
     {
       point c;
-      c.mSet( mx, my );
+      c.mSet( &frame, mx, my );
       pathingFills.push_back( c );
       return;
     }
@@ -174,7 +162,7 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
       if( strncmp( strName, "testDetectChoke", 15 ) == 0 )
       {
         point c;
-        c.mSet( mx, my );
+        c.mSet( &frame, mx, my );
         opennessNeighborhoodsToRender.push_back( c );
         return;
       }
@@ -212,7 +200,7 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
     string name( strType );
 
     FootToApply fta;
-    fta.loc.mSet( mx, my );
+    fta.loc.mSet( &frame, mx, my );
     fta.rot = rot;
     fta.type.assign( type );
     fta.name.assign( name );
@@ -264,7 +252,7 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
     FootToApply fta;
 
     string type( "destruct" );
-    fta.loc.mSet( mx, my );
+    fta.loc.mSet( &frame, mx, my );
     fta.rot = rot;
     fta.type.assign( type );
     fta.name.assign( name );
@@ -293,8 +281,8 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 
     if( strcmp( strType, poWatchtower ) == 0 )
     {
-      Watchtower* wt = new Watchtower;
-      wt->loc.mSet( mx, my );
+      Watchtower* wt = arena.make<Watchtower>();
+      wt->loc.mSet( &frame, mx, my );
       wt->range = 22.0f;
       watchtowers.push_back( wt );
       return;
@@ -302,15 +290,15 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 
     if( strcmp( strType, "MineralField" ) == 0 )
     {
-      Resource* r = new Resource;
-      r->loc.mSet( mx, my );
+      Resource* r = arena.makeOwned<Resource>();
+      r->loc.mSet( &frame, mx, my );
       r->cliffLevel = getHeight( &(r->loc) );
       r->type       = MINERALS;
       if( strResources != NULL )
       {
         r->amount = atof( strResources );
       } else {
-        r->amount = getfConstant( "defaultMineralAmount" );
+        r->amount = rc.defaultMineralAmount;
       }
       resources.push_back( r );
       return;
@@ -318,15 +306,15 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 
     if( strcmp( strType, poRichMineralField ) == 0 )
     {
-      Resource* r = new Resource;
-      r->loc.mSet( mx, my );
+      Resource* r = arena.makeOwned<Resource>();
+      r->loc.mSet( &frame, mx, my );
       r->cliffLevel = getHeight( &(r->loc) );
       r->type       = MINERALS_HY;
       if( strResources != NULL )
       {
         r->amount = atof( strResources );
       } else {
-        r->amount = getfConstant( "defaultMineralAmount" );
+        r->amount = rc.defaultMineralAmount;
       }
       resources.push_back( r );
       return;
@@ -335,15 +323,15 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
     if( strcmp( strType, "VespeneGeyser"       ) == 0 ||
         strcmp( strType, "SpacePlatformGeyser" ) == 0 )
     {
-      Resource* r = new Resource;
-      r->loc.mSet( mx, my );
+      Resource* r = arena.makeOwned<Resource>();
+      r->loc.mSet( &frame, mx, my );
       r->cliffLevel = getHeight( &(r->loc) );
       r->type       = VESPENEGAS;
       if( strResources != NULL )
       {
         r->amount = atof( strResources );
       } else {
-        r->amount = getfConstant( "defaultGeyserAmount" );
+        r->amount = rc.defaultGeyserAmount;
       }
       resources.push_back( r );
       return;
@@ -351,15 +339,15 @@ void SC2Map::processPlacedObject( ObjectMode objMode, TiXmlElement* object )
 
     if( strcmp( strType, "RichVespeneGeyser" ) == 0 )
     {
-      Resource* r = new Resource;
-      r->loc.mSet( mx, my );
+      Resource* r = arena.makeOwned<Resource>();
+      r->loc.mSet( &frame, mx, my );
       r->cliffLevel = getHeight( &(r->loc) );
       r->type       = VESPENEGAS_HY;
       if( strResources != NULL )
       {
         r->amount = atof( strResources );
       } else {
-        r->amount = getfConstant( "defaultGeyserAmount" );
+        r->amount = rc.defaultGeyserAmount;
       }
       resources.push_back( r );
       return;
@@ -394,14 +382,27 @@ void SC2Map::applyFillsAndFootprints()
   }
   pathingFills.clear();
 
+  // gather every cell the footprints remove from each
+  // path type, then clear them a whole word at a time
+  BitPlane clears[NUM_PATH_TYPES];
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    clears[t].resize( cxDimPlayable, cyDimPlayable );
+  }
+
   for( list<FootToApply>::iterator itr = footsToApply.begin();
        itr != footsToApply.end();
        ++itr )
   {
     FootToApply* fta = &(*itr);
-    applyFootprint( &(fta->loc), fta->rot, &(fta->type), &(fta->name) );
+    applyFootprint( &(fta->loc), fta->rot, &(fta->type), &(fta->name), clears );
   }
   footsToApply.clear();
+
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    mapPathing[t].andNotWith( &(clears[t]) );
+  }
 }
 
 
@@ -464,7 +465,7 @@ int SC2Map::makePointKey( point* c )
 void SC2Map::propagateFill( int dx, int dy, point* c, map<int, point>* fillSet, map<int, point>* workSet )
 {
   point cn;
-  cn.pcSet( c->pcx + dx, c->pcy + dy );
+  cn.pcSet( &frame, c->pcx + dx, c->pcy + dy );
 
   if( !isPlayableCell( &cn ) )
   {
@@ -490,7 +491,8 @@ void SC2Map::propagateFill( int dx, int dy, point* c, map<int, point>* fillSet,
 
 
 
-void SC2Map::applyFootprint( point* c, float rot, string* type, string* name )
+void SC2Map::applyFootprint( point* c, float rot, string* type, string* name,
+                             BitPlane* clears )
 {
   Footprint* foot = NULL;
 
@@ -562,7 +564,7 @@ void SC2Map::applyFootprint( point* c, float rot, string* type, string* name )
     int dy = *itr;
 
     point dc;
-    dc.pcSet( c->pcx + dx, c->pcy + dy );
+    dc.pcSet( &frame, c->pcx + dx, c->pcy + dy );
 
     if( !isPlayableCell( &dc ) )
     {
@@ -571,43 +573,43 @@ void SC2Map::applyFootprint( point* c, float rot, string* type, string* name )
 
     if( *type == "doodad" || *type == "unit" ) {
       // remove all pathing
-      setPathing( &dc, PATH_GROUND_NOROCKS,               false );
-      setPathing( &dc, PATH_GROUND_WITHROCKS,             false );
-      setPathing( &dc, PATH_CWALK_NOROCKS,                false );
-      setPathing( &dc, PATH_CWALK_WITHROCKS,              false );
-      setPathing( &dc, PATH_GROUND_WITHROCKS_NORESOURCES, false );
-      setPathing( &dc, PATH_BUILDABLE,                    false );
-      setPathing( &dc, PATH_BUILDABLE_MAIN,               false );
+      clears[PATH_GROUND_NOROCKS]              .set( dc.pcx, dc.pcy );
+      clears[PATH_GROUND_WITHROCKS]            .set( dc.pcx, dc.pcy );
+      clears[PATH_CWALK_NOROCKS]               .set( dc.pcx, dc.pcy );
+      clears[PATH_CWALK_WITHROCKS]             .set( dc.pcx, dc.pcy );
+      clears[PATH_GROUND_WITHROCKS_NORESOURCES].set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE]                   .set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE_MAIN]              .set( dc.pcx, dc.pcy );
 
     } else if( *type == "destruct" ) {
       // remove from WITHROCKS pathing types
-      setPathing( &dc, PATH_GROUND_WITHROCKS,             false );
-      setPathing( &dc, PATH_CWALK_WITHROCKS,              false );
-      setPathing( &dc, PATH_GROUND_WITHROCKS_NORESOURCES, false );
-      Destruct* destruct = new Destruct;
+      clears[PATH_GROUND_WITHROCKS]            .set( dc.pcx, dc.pcy );
+      clears[PATH_CWALK_WITHROCKS]             .set( dc.pcx, dc.pcy );
+      clears[PATH_GROUND_WITHROCKS_NORESOURCES].set( dc.pcx, dc.pcy );
+      Destruct* destruct = arena.make<Destruct>();
       destruct->loc.set( &dc );
       destructs.push_back( destruct );
 
     } else if( *type == "resource" ) {
       // remove all pathing except WITHOUTRESOURCES
-      setPathing( &dc, PATH_GROUND_NOROCKS,               false );
-      setPathing( &dc, PATH_GROUND_WITHROCKS,             false );
-      setPathing( &dc, PATH_CWALK_NOROCKS,                false );
-      setPathing( &dc, PATH_CWALK_WITHROCKS,              false );
-      setPathing( &dc, PATH_BUILDABLE,                    false );
-      setPathing( &dc, PATH_BUILDABLE_MAIN,               false );
+      clears[PATH_GROUND_NOROCKS]              .set( dc.pcx, dc.pcy );
+      clears[PATH_GROUND_WITHROCKS]            .set( dc.pcx, dc.pcy );
+      clears[PATH_CWALK_NOROCKS]               .set( dc.pcx, dc.pcy );
+      clears[PATH_CWALK_WITHROCKS]             .set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE]                   .set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE_MAIN]              .set( dc.pcx, dc.pcy );
 
     } else if( *type == "nobuildmain" ) {
-      setPathing( &dc, PATH_BUILDABLE_MAIN,               false );
+      clears[PATH_BUILDABLE_MAIN]              .set( dc.pcx, dc.pcy );
 
     } else if( *type == "nobuild" ) {
-      setPathing( &dc, PATH_BUILDABLE,                    false );
-      setPathing( &dc, PATH_BUILDABLE_MAIN,               false );
+      clears[PATH_BUILDABLE]                   .set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE_MAIN]              .set( dc.pcx, dc.pcy );
 
     } else if( *type == "losb" ) {
-      setPathing( &dc, PATH_BUILDABLE,                    false );
-      setPathing( &dc, PATH_BUILDABLE_MAIN,               false );
-      LoSB* losb = new LoSB;
+      clears[PATH_BUILDABLE]                   .set( dc.pcx, dc.pcy );
+      clears[PATH_BUILDABLE_MAIN]              .set( dc.pcx, dc.pcy );
+      LoSB* losb = arena.make<LoSB>();
       losb->loc.set( &dc );
       losbs.push_back( losb );
 
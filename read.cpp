@@ -17,6 +17,9 @@ int SC2Map::readMap()
 {
   HANDLE archive;
 
+  // the config for this map is in by now, so settle it
+  resolveConfig();
+
   string fullArchiveName( argPath );
   fullArchiveName.append( archiveWithExt );
 
@@ -287,6 +290,8 @@ void SC2Map::makeMapNameValidForFilenames()
     mapNameInOutputFiles.assign( prefix );
   }
 
+  pthread_mutex_lock( &mapFilenamesLock );
+
   set<string>::iterator sItr = mapFilenamesUsed.find( mapNameInOutputFiles );
   if( sItr != mapFilenamesUsed.end() )
   {
@@ -311,6 +316,8 @@ void SC2Map::makeMapNameValidForFilenames()
   }
 
   mapFilenamesUsed.insert( mapNameInOutputFiles );
+
+  pthread_mutex_unlock( &mapFilenamesLock );
 }
 
 
@@ -488,10 +495,10 @@ int SC2Map::readMapInfo( const HANDLE archive )
     // (not read in by this function) but pass them
     // in now to set up translation so we can start
     // using points
-    point::setFrameTranslationConstants( mcLeft,
-                                         mcBottom,
-                                         iDimT,
-                                         iDimC );
+    frame.set( mcLeft,
+               mcBottom,
+               iDimT,
+               iDimC );
     cxDimMap = mcWidth;
     cyDimMap = mcHeight;
     txDimMap = cxDimMap + 1;
@@ -504,13 +511,13 @@ int SC2Map::readMapInfo( const HANDLE archive )
 
     // set the coordinates of the playable area in cell
     // coordinates, which they are natively given in
-    cLeftBottom.mcSet( mcLeft,  mcBottom );
-    cRightTop  .mcSet( mcRight, mcTop    );
+    cLeftBottom.mcSet( &frame, mcLeft,  mcBottom );
+    cRightTop  .mcSet( &frame, mcRight, mcTop    );
 
     // this is a purposeful translation of cell coordinates
     // to terrain coordinates so we know the playable terrain
-    tLeftBottom.mtSet( mcLeft,      mcBottom     );
-    tRightTop  .mtSet( mcWidth + 1, mcHeight + 1 );
+    tLeftBottom.mtSet( &frame, mcLeft,      mcBottom     );
+    tRightTop  .mtSet( &frame, mcWidth + 1, mcHeight + 1 );
 
     // if we processed to the end with no problem,
     // report no problem
@@ -623,7 +630,7 @@ int SC2Map::readt3HeightMap( const HANDLE archive )
   {
     // the data for analysis only includes the
     // playable area, but...
-    mapHeight = new u8[txDimPlayable*tyDimPlayable];
+    mapHeight.resize( txDimPlayable, tyDimPlayable, 0, 0 );
 
     // we gotta scan the whole file to get what we want
     for( int mtj = 0; mtj < tyDimMap; ++mtj )
@@ -642,7 +649,7 @@ int SC2Map::readt3HeightMap( const HANDLE archive )
         }
 
         point t;
-        t.mtSet( mti, mtj );
+        t.mtSet( &frame, mti, mtj );
         if( isPlayableTerrain( &t ) )
         {
           setHeight( &t, h );
@@ -674,64 +681,38 @@ int SC2Map::readt3HeightMap( const HANDLE archive )
 
 void SC2Map::setHeight( point* t, u8 h )
 {
-  if( !isPlayableTerrain( t ) )
-  {
-    printError( "Attempt to access data from unplayable terrain (%d, %d)\n",
-                t->ptx,
-                t->pty );
-    exit( -1 );
-  }
-  mapHeight[t->pty*txDimPlayable + t->ptx] = h;
+  mapHeight.set( t->ptx, t->pty, h );
 }
 
 
 u8 SC2Map::getHeight( point* t ) {
-
-  if( !isPlayableTerrain( t ) )
-  {
-    printError( "Attempt to access data from unplayable terrain (%d, %d)\n",
-                t->ptx,
-                t->pty );
-    exit( -1 );
-  }
-  
-  if( t->ptx == point::ptNaN ) {
-    printError( "Expected a terrain point.\n" );
-    exit( -1 );
-  }
-  
-  return mapHeight[t->pty*txDimPlayable + t->ptx];
+  return mapHeight.get( t->ptx, t->pty );
 }
 
 
+// the four terrain points around the cell are checked,
+// which covers exactly the playable cells
 u8 SC2Map::getHeightCell( point* c ) {
+  return (mapHeight.get( c->pcx + 1, c->pcy + 1 ) +
+          mapHeight.get( c->pcx + 1, c->pcy     ) +
+          mapHeight.get( c->pcx,     c->pcy     ) +
+          mapHeight.get( c->pcx,     c->pcy + 1 )) / 4;
+}
 
-  if( !isPlayableCell( c ) )
-  {
-    printError( "Attempt to access data from unplayable cell (%d, %d)\n",
-                c->pcx,
-                c->pcy );
-    exit( -1 );
-  }
-  
-  if( c->pcx == point::pcNaN ) {
-    printError( "Expected a cell point.\n" );
-    exit( -1 );
-  }
 
-  point t_ur;  t_ur.ptSet( c->pcx + 1, c->pcy + 1 );
-  point t_lr;  t_lr.ptSet( c->pcx + 1, c->pcy     );
-  point t_ll;  t_ll.ptSet( c->pcx,     c->pcy     );
-  point t_ul;  t_ul.ptSet( c->pcx,     c->pcy + 1 );
+// no checks here, for loops over cells that are known to
+// be playable--the terrain points around a playable cell
+// are always playable terrain
+u8 SC2Map::getHeightCell( cell c ) {
 
   // this isn't a well-defined concept for cells with
   // a bunch of neighboring heights, which is ok because
   // those kinds of cells don't usually render any interesting
   // game info because they are unpathable
-  return (getHeight( &t_ur ) +
-          getHeight( &t_lr ) +
-          getHeight( &t_ll ) +
-          getHeight( &t_ul )) / 4;
+  return (mapHeight.at( c.pcx + 1, c.pcy + 1 ) +
+          mapHeight.at( c.pcx + 1, c.pcy     ) +
+          mapHeight.at( c.pcx,     c.pcy     ) +
+          mapHeight.at( c.pcx,     c.pcy + 1 )) / 4;
 }
       
 
@@ -774,7 +755,7 @@ int SC2Map::readPaintedPathingLayer( const HANDLE archive )
     int rmn = i % (4*256);
     int mcx = rmn / 4;
 
-    c.mcSet( mcx, mcy );
+    c.mcSet( &frame, mcx, mcy );
 
     if( !isPlayableCell( &c ) )
     {
@@ -859,8 +840,10 @@ int SC2Map::readObjects( const HANDLE archive )
 
   bool continueProcessing = true;
 
-  // we need a FILE* instead of data buffer for tinyxml lib
-  char strTemp[] = "Objects.tmp";
+  // we need a FILE* instead of data buffer for tinyxml lib,
+  // maps read at the same time each need their own file
+  char strTemp[FILENAME_LENGTH];
+  sprintf( strTemp, "Objects-%p.tmp", (void*)this );
   FILE* fileTemp = fopen( strTemp, "w+" );
 
   if( fileTemp == NULL )
@@ -1074,11 +1057,7 @@ int SC2Map::readt3CellFlags( const HANDLE archive )
   if( continueProcessing )
   {
     // an intermediate structure to get pathing right
-    mapCliffChanges = new bool[(cxDimMap/2)*(cyDimMap/2)];
-    for( int i = 0; i < (cxDimMap/2)*(cyDimMap/2); ++i )
-    {
-      mapCliffChanges[i] = false;
-    }
+    mapCliffChanges.resize( cxDimMap/2, cyDimMap/2, 0, false );
 
     // scan the whole map
     for( int mcj = 0; mcj < cyDimMap; ++mcj )
@@ -1092,7 +1071,7 @@ int SC2Map::readt3CellFlags( const HANDLE archive )
         bool groundPathable = ~flags & 0x1;
 
         point c;
-        c.mcSet( mci, mcj );
+        c.mcSet( &frame, mci, mcj );
 
         setMapCliffChange( &c, groundPathable );
       }
@@ -1135,8 +1114,10 @@ int SC2Map::readt3Terrain_xml( const HANDLE archive )
 
   bool continueProcessing = true;
 
-  // we need a FILE* instead of data buffer for tinyxml lib
-  char strTemp[] = "t3Terrain.tmp";
+  // we need a FILE* instead of data buffer for tinyxml lib,
+  // maps read at the same time each need their own file
+  char strTemp[FILENAME_LENGTH];
+  sprintf( strTemp, "t3Terrain-%p.tmp", (void*)this );
   FILE* fileTemp = fopen( strTemp, "w+" );
 
   if( fileTemp == NULL )
@@ -1,15 +1,13 @@
 #include <stdlib.h>
 #include <math.h>
-#include <errno.h>
 
 #include <string>
 using namespace std;
 
-#include "pngwriter.h"
-
 #include "utility.hpp"
 #include "outstreams.hpp"
 #include "coordinates.hpp"
+#include "Canvas.hpp"
 #include "SC2Map.hpp"
 
 
@@ -32,15 +30,30 @@ int SC2Map::iDimC = 6;
 //
 /////////////////////////////////////////////////
 
-int SC2Map::iLeft   = 0;
-int SC2Map::iBottom = 0;
-int SC2Map::iRight  = 0;
-int SC2Map::iTop    = 0;
+__thread int SC2Map::iLeft   = 0;
+__thread int SC2Map::iBottom = 0;
+__thread int SC2Map::iRight  = 0;
+__thread int SC2Map::iTop    = 0;
+
+
+// threads other than the render workers
+// always draw with the first canvas
+__thread Canvas* SC2Map::img          = NULL;
+__thread int     SC2Map::renderWorker = 0;
 
 
 int SC2Map::iFooterHeight = 68;
 
 
+// the cached layers reach this far past the
+// image frame on every side
+int SC2Map::iLayerMargin = 32;
+
+
+// every bit of text is in this font
+const char* SC2Map::fontface = "./FreeSansBold.ttf";
+
+
 // when plotting shortest paths this constant is
 // related to dealing with patch distances
 static const float dNoOverride = -1.0f;
@@ -64,15 +77,30 @@ int SC2Map::iy2png( int iy ) {
 
 
 
-void SC2Map::resetPNGWriter( const char* strFileSuffix,
-                             int         iBorderLeft,
-                             int         iBorderRight,
-                             int         iBorderTop,
-                             int         iBorderBottom ) {
+void SC2Map::resetCanvas( const char* strFileSuffix,
+                          int         iBorderLeft,
+                          int         iBorderRight,
+                          int         iBorderTop,
+                          int         iBorderBottom ) {
+  resetCanvas( canvases[renderWorker],
+               strFileSuffix,
+               iBorderLeft,
+               iBorderRight,
+               iBorderTop,
+               iBorderBottom );
+}
+
+void SC2Map::resetCanvas( Canvas*     canvas,
+                          const char* strFileSuffix,
+                          int         iBorderLeft,
+                          int         iBorderRight,
+                          int         iBorderTop,
+                          int         iBorderBottom ) {
   string strOut( outputPath );
   strOut += "\\" + this->mapNameInOutputFiles + strFileSuffix + ".png";
 
-  img->pngwriter_rename( strOut.data() );
+  img = canvas;
+  img->setFilename( strOut.data() );
 
   // this resize of the image buffer implicitly colors
   // all pixels black
@@ -102,7 +130,6 @@ void SC2Map::renderFooter() {
             14,          // font size
             false,       // centered,
             20, 42,      // bottom-left
-            0.0f,        // angle
             getColor( "footerTxtFg" ),
             getColor( "footerTxtBg" ) );
 
@@ -112,204 +139,637 @@ void SC2Map::renderFooter() {
             14,          // font size
             false,       // centered,
             20, 20,      // bottom-left
-            0.0f,        // angle
             getColor( "footerTxtFg" ),
             getColor( "footerTxtBg" ) );
 }
 
 
-void SC2Map::renderImageTerrainOnly() {
+// the images drawn over a layer of cells are started one
+// after another, then the cells are walked once to fill
+// every one of them, then each is finished and closed
+void SC2Map::renderCellImages( bool terrain,
+                               bool pathing,
+                               bool bases,
+                               bool openness,
+                               bool summary )
+{
+  PathType pathingTypes[] =
+  {
+    PATH_GROUND_WITHROCKS,
+    PATH_GROUND_NOROCKS,
+    PATH_CWALK_WITHROCKS,
+    PATH_CWALK_NOROCKS,
+    PATH_GROUND_WITHROCKS_NORESOURCES,
+    PATH_BUILDABLE,
+    PATH_BUILDABLE_MAIN,
+  };
 
-  resetPNGWriter( "-terrain-only",
-                  20, 20,
-                  58,
-                  iFooterHeight );
+  vector<CellImage> images;
+  CellImage ci;
 
-  char title[2*FILENAME_LENGTH];
-  sprintf( title,
-           "%s - Terrain only",
-           mapName.data() );
+  if( terrain )
+  {
+    ci.kind = CELLIMAGE_TERRAIN;
+    ci.t    = PATH_GROUND_WITHROCKS;
+    images.push_back( ci );
+  }
 
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+20, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
+  if( pathing )
+  {
+    for( int i = 0; i < getArrLength( pathingTypes ); ++i )
+    {
+      ci.kind = CELLIMAGE_PATHING;
+      ci.t    = pathingTypes[i];
+      images.push_back( ci );
+    }
+  }
 
-  renderTerrain();
-  renderFooter();
-  img->close();
+  if( bases )
+  {
+    ci.kind = CELLIMAGE_BASES;
+    ci.t    = PATH_GROUND_WITHROCKS;
+    images.push_back( ci );
+  }
+
+  if( openness )
+  {
+    ci.kind = CELLIMAGE_OPENNESS;
+    ci.t    = PATH_GROUND_WITHROCKS;
+    images.push_back( ci );
+  }
+
+  if( summary )
+  {
+    ci.kind = CELLIMAGE_SUMMARY;
+    ci.t    = PATH_GROUND_WITHROCKS;
+    images.push_back( ci );
+  }
+
+  if( images.empty() )
+  {
+    return;
+  }
+
+  // every image is open at once, so each needs a canvas,
+  // the workers' canvases are free while this runs
+  while( canvases.size() < images.size() )
+  {
+    canvases.push_back( new Canvas() );
+  }
+
+  for( int i = 0; i < (int)images.size(); ++i )
+  {
+    images[i].canvas = canvases[i];
+    beginCellImage( &(images[i]) );
+  }
+
+  renderCells( &images );
+
+  for( int i = 0; i < (int)images.size(); ++i )
+  {
+    finishCellImage( &(images[i]) );
+  }
+
+  img = canvases[renderWorker];
 }
 
 
-void SC2Map::renderImagesPathing() {
-  renderImagePathing( "-pathingGroundWithRocks",            PATH_GROUND_WITHROCKS             );
-  renderImagePathing( "-pathingGroundNoRocks",              PATH_GROUND_NOROCKS               );
-  renderImagePathing( "-pathingCliffWalkWithRocks",         PATH_CWALK_WITHROCKS              );
-  renderImagePathing( "-pathingCliffWalkNoRocks",           PATH_CWALK_NOROCKS                );
-  renderImagePathing( "-pathingGroundWithRocksNoResources", PATH_GROUND_WITHROCKS_NORESOURCES );
-  renderImagePathing( "-pathingBuildable",                  PATH_BUILDABLE                    );
-  renderImagePathing( "-pathingMainBuildings",              PATH_BUILDABLE_MAIN               );
+// draw into this image from now on
+void SC2Map::useCellImage( CellImage* ci )
+{
+  img     = ci->canvas;
+  iLeft   = ci->iLeft;
+  iBottom = ci->iBottom;
+  iRight  = ci->iRight;
+  iTop    = ci->iTop;
 }
 
-void SC2Map::renderImagePathing( const char* strOutPNG,
-                                 PathType    t ) {
-                                 
-  resetPNGWriter( strOutPNG,
-                  20, 20,
-                  58,
-                  iFooterHeight );
 
-  char strPath[64];
-  switch( t )
+// everything that goes under the cells
+void SC2Map::beginCellImage( CellImage* ci )
+{
+  char title[2*FILENAME_LENGTH];
+
+  switch( ci->kind )
   {
-    case PATH_GROUND_WITHROCKS:
+    case CELLIMAGE_TERRAIN:
     {
-      sprintf( strPath, "Ground pathing, with rocks" );
+      resetCanvas( ci->canvas,
+                   "-terrain-only",
+                   20, 20,
+                   58,
+                   iFooterHeight );
+
+      sprintf( title,
+               "%s - Terrain only",
+               mapName.data() );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+20, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
     } break;
 
-    case PATH_GROUND_NOROCKS:
+    case CELLIMAGE_PATHING:
     {
-      sprintf( strPath, "Ground pathing, without rocks" );
+      const char* strOutPNG;
+      const char* strPath;
+
+      switch( ci->t )
+      {
+        case PATH_GROUND_WITHROCKS:
+        {
+          strOutPNG = "-pathingGroundWithRocks";
+          strPath   = "Ground pathing, with rocks";
+        } break;
+
+        case PATH_GROUND_NOROCKS:
+        {
+          strOutPNG = "-pathingGroundNoRocks";
+          strPath   = "Ground pathing, without rocks";
+        } break;
+
+        case PATH_CWALK_WITHROCKS:
+        {
+          strOutPNG = "-pathingCliffWalkWithRocks";
+          strPath   = "Cliff-walk pathing, with rocks";
+        } break;
+
+        case PATH_CWALK_NOROCKS:
+        {
+          strOutPNG = "-pathingCliffWalkNoRocks";
+          strPath   = "Cliff-walk pathing, without rocks";
+        } break;
+
+        case PATH_GROUND_WITHROCKS_NORESOURCES:
+        {
+          strOutPNG = "-pathingGroundWithRocksNoResources";
+          strPath   = "Ground pathing, w/ rocks, no resouces";
+        } break;
+
+        case PATH_BUILDABLE:
+        {
+          strOutPNG = "-pathingBuildable";
+          strPath   = "Buildable pathing";
+        } break;
+
+        case PATH_BUILDABLE_MAIN:
+        {
+          strOutPNG = "-pathingMainBuildings";
+          strPath   = "Main building pathing";
+        } break;
+
+        default:
+          strOutPNG = "-pathingUnknown";
+          strPath   = "UNKNOWN PATHING TYPE?";
+      }
+
+      resetCanvas( ci->canvas,
+                   strOutPNG,
+                   20, 20,
+                   58,
+                   iFooterHeight );
+
+      sprintf( title,
+               "%s - %s",
+               mapName.data(),
+               strPath );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+20, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
     } break;
 
-    case PATH_CWALK_WITHROCKS:
+    case CELLIMAGE_BASES:
     {
-      sprintf( strPath, "Cliff-walk pathing, with rocks" );
+      resetCanvas( ci->canvas,
+                   "-bases",
+                   20, 20,
+                   58,
+                   iFooterHeight );
+
+      sprintf( title,
+               "%s - Bases identified (tot. resources, avg. openness)",
+               mapName.data() );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+20, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
     } break;
 
-    case PATH_CWALK_NOROCKS:
+    case CELLIMAGE_OPENNESS:
     {
-      sprintf( strPath, "Cliff-walk pathing, without rocks" );
+      resetCanvas( ci->canvas,
+                   "-openness",
+                   20, 20, // borders left right
+                   86,     // border top
+                   iFooterHeight );   // border bottom
+
+      sprintf( title,
+               "%s - Openness, by ground pathing with rocks",
+               mapName.data() );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+48, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
+
+      renderOpennessLegend();
+
+      // the openness cells go over the terrain here
+      pasteTerrain();
     } break;
 
-    case PATH_GROUND_WITHROCKS_NORESOURCES:
+    case CELLIMAGE_SUMMARY:
     {
-      sprintf( strPath, "Ground pathing, w/ rocks, no resouces" );
+      resetCanvas( ci->canvas,
+                   "-summary",
+                   20, 20, // borders left right
+                   86,     // border top
+                   iFooterHeight );   // border bottom
+
+      sprintf( title,
+               "%s - Summary",
+               mapName.data() );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+48, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
+
+      sprintf( title,
+               "Avg. Openness: %.2f,  Watchtower Coverage: %.1f%%",
+               opennessAvg[PATH_GROUND_WITHROCKS],
+               100.0f * watchtowerCoverage );
+
+      plotText( title,
+                18,          // font size
+                false,       // centered,
+                20, iTop+24, // bottom-left
+                getColor( "defaultTxtFg" ),
+                getColor( "defaultTxtBg" ) );
     } break;
+  }
+
+  ci->iLeft   = iLeft;
+  ci->iBottom = iBottom;
+  ci->iRight  = iRight;
+  ci->iTop    = iTop;
+}
 
-    case PATH_BUILDABLE:
+
+// the single walk over the cells, each row of cells is
+// shaded once into a row of pixels for every kind of cell
+// layer that is wanted, and that row is copied into every
+// image that shows it
+void SC2Map::renderCells( vector<CellImage>* images )
+{
+  bakeGradients();
+
+  bool wantPathing[NUM_PATH_TYPES];
+  bool wantOpenness[NUM_PATH_TYPES];
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    wantPathing [t] = false;
+    wantOpenness[t] = false;
+  }
+
+  for( int i = 0; i < (int)images->size(); ++i )
+  {
+    CellImage* ci = &((*images)[i]);
+
+    switch( ci->kind )
+    {
+      case CELLIMAGE_PATHING:
+        wantPathing[ci->t] = true;
+      break;
+
+      case CELLIMAGE_BASES:
+      case CELLIMAGE_OPENNESS:
+      case CELLIMAGE_SUMMARY:
+        wantOpenness[ci->t] = true;
+      break;
+
+      default:
+      break;
+    }
+  }
+
+  int rowLen = cxDimPlayable*iDimT;
+
+  vector<u8> pathingRows [NUM_PATH_TYPES];
+  vector<u8> opennessRows[NUM_PATH_TYPES];
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    if( wantPathing[t] )
+    {
+      pathingRows[t].resize( 3*rowLen );
+    }
+    if( wantOpenness[t] )
     {
-      sprintf( strPath, "Buildable pathing" );
+      opennessRows[t].resize( 3*rowLen );
+    }
+  }
+
+  u8 clear  [3];
+  u8 blocked[3];
+  Canvas::toRGB8( &(rc.pathingClear  ), clear   );
+  Canvas::toRGB8( &(rc.pathingBlocked), blocked );
+
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+  {
+    for( int t = 0; t < NUM_PATH_TYPES; ++t )
+    {
+      if( wantPathing[t] )
+      {
+        // runs of same-valued cells come straight
+        // out of the pathing plane's words
+        u8* row = &(pathingRows[t][0]);
+
+        int pci = 0;
+        while( pci < cxDimPlayable )
+        {
+          int pciEnd = mapPathing[t].runEnd( pci, pcj );
+          u8* rgb    = mapPathing[t].get( pci, pcj ) ? clear : blocked;
+
+          for( u8* p = row + 3*iDimT*pci; p < row + 3*iDimT*pciEnd; p += 3 )
+          {
+            p[0] = rgb[0];
+            p[1] = rgb[1];
+            p[2] = rgb[2];
+          }
+
+          pci = pciEnd;
+        }
+      }
+
+      if( wantOpenness[t] )
+      {
+        u8* row = &(opennessRows[t][0]);
+
+        for( int pci = 0; pci < cxDimPlayable; ++pci )
+        {
+          Color color;
+          opennessColor( cell( pci, pcj ), (PathType)t, &color );
+
+          u8 rgb[3];
+          Canvas::toRGB8( &color, rgb );
+
+          for( u8* p = row + 3*iDimT*pci; p < row + 3*iDimT*(pci + 1); p += 3 )
+          {
+            p[0] = rgb[0];
+            p[1] = rgb[1];
+            p[2] = rgb[2];
+          }
+        }
+      }
+    }
+
+    for( int i = 0; i < (int)images->size(); ++i )
+    {
+      CellImage* ci = &((*images)[i]);
+
+      u8* row;
+      switch( ci->kind )
+      {
+        case CELLIMAGE_PATHING:
+          row = &(pathingRows[ci->t][0]);
+        break;
+
+        case CELLIMAGE_BASES:
+        case CELLIMAGE_OPENNESS:
+        case CELLIMAGE_SUMMARY:
+          row = &(opennessRows[ci->t][0]);
+        break;
+
+        default:
+          row = NULL;
+        break;
+      }
+
+      if( row == NULL )
+      {
+        continue;
+      }
+
+      // the bottom-left pixel of the row of cells, a cell
+      // is iDimT pixels tall so the row is copied up
+      useCellImage( ci );
+      int x0 = ix2png( 0 );
+      int y0 = iy2png( iDimT*pcj );
+
+      for( int y = y0; y < y0 + iDimT; ++y )
+      {
+        ci->canvas->copyRow( x0, y, rowLen, row );
+      }
+    }
+  }
+}
+
+
+// everything that goes over the cells
+void SC2Map::finishCellImage( CellImage* ci )
+{
+  useCellImage( ci );
+
+  switch( ci->kind )
+  {
+    case CELLIMAGE_TERRAIN:
+    {
+      pasteTerrain();
     } break;
 
-    case PATH_BUILDABLE_MAIN:
+    case CELLIMAGE_PATHING:
     {
-      sprintf( strPath, "Main building pathing" );
+      pasteTerrain();
+      renderStartLocs();
     } break;
 
-    default:
-      sprintf( strPath, "UNKNOWN PATHING TYPE?" );
-  }
+    case CELLIMAGE_BASES:
+    {
+      pasteTerrain();
+      pasteStaticObjects();
+      renderBasesDebug();
+    } break;
 
-  char title[2*FILENAME_LENGTH];
-  sprintf( title,
-           "%s - %s",
-           mapName.data(),
-           strPath );
+    case CELLIMAGE_OPENNESS:
+    {
+      pasteStaticObjects();
+      renderStartLocs();
+    } break;
 
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+20, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
+    case CELLIMAGE_SUMMARY:
+    {
+      //pasteTerrain();
+      pasteStaticObjects();
+      renderChokes();
+      renderBases();
+      renderSpaceInMain();
+      renderWatchtowers();
+    } break;
+  }
 
-  renderPathing( t );
-  renderTerrain();
-  renderStartLocs();
   renderFooter();
-  img->close();
+  img->close( &(rc.pngProfile) );
 }
 
 
-void SC2Map::renderImageBases() {
+void SC2Map::renderImagesShortestPaths() {
+  renderPairs( &SC2Map::renderImagesShortestPaths );
+}
 
-  resetPNGWriter( "-bases",
-                  20, 20,
-                  58,
-                  iFooterHeight );
+
+void SC2Map::renderImagesShortestPaths( StartLoc* sl1, StartLoc* sl2 ) {
+  char filename[FILENAME_LENGTH];
+  sprintf( filename, "-shortestPaths-%d-%d", sl1->idNum, sl2->idNum );
 
   char title[2*FILENAME_LENGTH];
   sprintf( title,
-           "%s - Bases identified (tot. resources, avg. openness)",
-           mapName.data() );
+           "%s - Shortest paths, %s to %s",
+           mapName.data(),
+           sl1->name,
+           sl2->name );
 
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+20, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
+  renderImageShortestPaths( filename,
+                            title,
+                            &(sl1->loc),
+                            NULL,
+                            &(sl2->loc),
+                            NULL );
 
-  renderOpenness( PATH_GROUND_WITHROCKS );
-  renderTerrain();
-  renderDestructs();
-  renderLoSBs();
-  renderResources();
-  renderBasesDebug();
-  renderFooter();
-  img->close();
+  if( sl1->natBase != NULL &&
+      sl2->natBase != NULL &&
+      sl1->natBase != sl2->natBase )
+  {
+    sprintf( filename, "-shortestPaths-%d-%d-nats", sl1->idNum, sl2->idNum );
+
+    sprintf( title,
+             "%s - Shortest paths, naturals, %s to %s",
+             mapName.data(),
+             sl1->name,
+             sl2->name );
+
+    renderImageShortestPaths( filename,
+                              title,
+                              NULL,
+                              sl1->natBase,
+                              NULL,
+                              sl2->natBase );
+  }
 }
 
 
-void SC2Map::renderImagesShortestPaths() {
+
+// the pairs are listed in the order the images used to
+// be drawn in, the workers take them from the front
+struct RenderPairJobs
+{
+  SC2Map* sc2map;
+  void (SC2Map::*renderPair)( StartLoc*, StartLoc* );
+
+  vector<StartLoc*> sl1s;
+  vector<StartLoc*> sl2s;
+};
+
+
+void SC2Map::renderPairs( void (SC2Map::*renderPair)( StartLoc*, StartLoc* ) )
+{
+  prepRenderWorkers();
+
+  RenderPairJobs jobs;
+  jobs.sc2map     = this;
+  jobs.renderPair = renderPair;
+
   for( list<StartLoc*>::const_iterator itr1 = startLocs.begin();
        itr1 != startLocs.end();
        ++itr1 )
   {
-    StartLoc* sl1 = *itr1;
-
     list<StartLoc*>::const_iterator itr2 = itr1;
     ++itr2;
     for( ;
          itr2 != startLocs.end();
          ++itr2 )
     {
-      StartLoc* sl2 = *itr2;
+      jobs.sl1s.push_back( *itr1 );
+      jobs.sl2s.push_back( *itr2 );
+    }
+  }
 
-      char filename[FILENAME_LENGTH];
-      sprintf( filename, "-shortestPaths-%d-%d", sl1->idNum, sl2->idNum );
+  renderPool->run( jobs.sl1s.size(), &renderPairJob, &jobs );
+}
 
-      char title[2*FILENAME_LENGTH];
-      sprintf( title,
-               "%s - Shortest paths, %s to %s",
-               mapName.data(),
-               sl1->name,
-               sl2->name );
-
-      renderImageShortestPaths( filename,
-                                title,
-                                &(sl1->loc),
-                                NULL,
-                                &(sl2->loc),
-                                NULL );
-
-      if( sl1->natBase != NULL &&
-          sl2->natBase != NULL &&
-          sl1->natBase != sl2->natBase )
+
+void SC2Map::renderPairJob( void* context, int job, int worker )
+{
+  RenderPairJobs* jobs = (RenderPairJobs*)context;
+
+  renderWorker = worker;
+
+  (jobs->sc2map->*(jobs->renderPair))( jobs->sl1s[job], jobs->sl2s[job] );
+}
+
+
+void SC2Map::prepRenderWorkers()
+{
+  bakeGradients();
+  bakeStamps();
+  bakeLayers();
+
+  // shortest paths are searched for the first time they're
+  // asked for, do every search the pair images will need
+  // now so the workers never write to the path tables
+  PathType types[] = { PATH_GROUND_WITHROCKS, PATH_CWALK_WITHROCKS };
+
+  for( list<StartLoc*>::const_iterator itr = startLocs.begin();
+       itr != startLocs.end();
+       ++itr )
+  {
+    StartLoc* sl = *itr;
+
+    for( int i = 0; i < getArrLength( types ); ++i )
+    {
+      PathType t = types[i];
+
+      Node* u = getPathNode( &(sl->loc), t );
+      if( u != NULL )
       {
-        sprintf( filename, "-shortestPaths-%d-%d-nats", sl1->idNum, sl2->idNum );
-
-        sprintf( title,
-                 "%s - Shortest paths, naturals, %s to %s",
-                 mapName.data(),
-                 sl1->name,
-                 sl2->name );
-
-        renderImageShortestPaths( filename,
-                                  title,
-                                  NULL,
-                                  sl1->natBase,
-                                  NULL,
-                                  sl2->natBase );
+        requireShortestPaths( u, t );
+      }
+
+      if( sl->natBase == NULL )
+      {
+        continue;
+      }
+
+      PatchNodes* patches = &(sl->natBase->node2patchDistance[t]);
+      for( int j = 0; j < patches->count; ++j )
+      {
+        requireShortestPaths( nodes[t][patches->entries[j].id], t );
       }
     }
   }
+
+  if( renderPool == NULL )
+  {
+    renderPool = new WorkerPool( rc.renderThreads );
+
+    while( (int)canvases.size() < renderPool->numWorkers )
+    {
+      canvases.push_back( new Canvas() );
+    }
+  }
 }
 
 
@@ -329,16 +789,15 @@ void SC2Map::renderImageShortestPaths( char*  filename,
     exit( -1 );
   }
 
-  resetPNGWriter( filename,
-                  20, 20, // borders left right
-                  86,     // border top
-                  iFooterHeight );   // border bottom
+  resetCanvas( filename,
+               20, 20, // borders left right
+               86,     // border top
+               iFooterHeight );   // border bottom
 
   plotText( title,
             18,          // font size
             false,       // centered,
             20, iTop+48, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -352,7 +811,6 @@ void SC2Map::renderImageShortestPaths( char*  filename,
             18,                       // font size
             false,                    // centered,
             20 + textOffset, iTop+20, // bottom-left
-            0.0f,                     // angle
             getColor( "shortestPathAir" ),
             getColor( "defaultTxtBg" ) );
 
@@ -364,7 +822,6 @@ void SC2Map::renderImageShortestPaths( char*  filename,
             18,                       // font size
             false,                    // centered,
             20 + textOffset, iTop+20, // bottom-left
-            0.0f,                     // angle
             getColor( "shortestPathGround" ),
             getColor( "defaultTxtBg" ) );
 
@@ -376,15 +833,12 @@ void SC2Map::renderImageShortestPaths( char*  filename,
             18,                       // font size
             false,                    // centered,
             20 + textOffset, iTop+20, // bottom-left
-            0.0f,                     // angle
             getColor( "shortestPathCWalk" ),
             getColor( "defaultTxtBg" ) );
 
-  renderTerrain();
+  pasteTerrain();
   renderPathing( PATH_GROUND_WITHROCKS );
-  renderDestructs();
-  renderLoSBs();
-  renderResources();
+  pasteStaticObjects();
 
   if( p0 != NULL && p1 != NULL )
   {
@@ -413,7 +867,7 @@ void SC2Map::renderImageShortestPaths( char*  filename,
 
   renderStartLocs();
   renderFooter();
-  img->close();
+  img->close( &(rc.pngProfile) );
 }
 
 
@@ -443,7 +897,6 @@ void SC2Map::plotAirPath( point* p0, point* p1,
             true,               // centered
             ix2png( ixLabel ),
             iy2png( iyLabel ),
-            0.0f,               // angle
             color,
             getColor( "defaultTxtBg" ) );
 }
@@ -566,45 +1019,27 @@ void SC2Map::plotShortestPath( point* p0, point* p1, PathType t,
             true,               // centered
             ix2png( ixLabel ),
             iy2png( iyLabel ),
-            0.0f,               // angle
             color,
             getColor( "defaultTxtBg" ) );
 }
 
 
 
-void SC2Map::renderImageOpenness()
+// the scale of openness colors along the top of the image
+void SC2Map::renderOpennessLegend()
 {
-  resetPNGWriter( "-openness",
-                  20, 20, // borders left right
-                  86,     // border top
-                  iFooterHeight );   // border bottom
-
-  char title[2*FILENAME_LENGTH];
-  sprintf( title,
-           "%s - Openness, by ground pathing with rocks",
-           mapName.data() );
-
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+48, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
-
   Color color;
 
   for( int i = 0; i < 255; ++i )
   {
     float fi       = (float)i;
-    float openness = getfConstant( "opennessRenderMax" ) * fi / 200.0f;
+    float openness = rc.opennessRenderMax * fi / 200.0f;
 
     openness2color( openness, &color );
 
     img->line( 30+i, iTop+18,
                30+i, iTop+40,
-               color.r, color.g, color.b );
+               &color );
   }
 
   char num[32];
@@ -615,131 +1050,128 @@ void SC2Map::renderImageOpenness()
             16,          // font size
             true,        // centered,
             50, iTop+30, //
-            0.0f,        // angle
             &color,
             getColor( "defaultTxtBg" ) );
 
-  openness2color( getfConstant( "opennessRenderMax" )*0.5f, &color );
-  sprintf( num, "%.1f", getfConstant( "opennessRenderMax" )*0.5f );
+  openness2color( rc.opennessRenderMax*0.5f, &color );
+  sprintf( num, "%.1f", rc.opennessRenderMax*0.5f );
   plotText( num,
             16,           // font size
             true,         // centered,
             150, iTop+30, //
-            0.0f,         // angle
             &color,
             getColor( "defaultTxtBg" ) );
 
-  openness2color( getfConstant( "opennessRenderMax" ), &color );
-  sprintf( num, "%.1f+", getfConstant( "opennessRenderMax" ) );
+  openness2color( rc.opennessRenderMax, &color );
+  sprintf( num, "%.1f+", rc.opennessRenderMax );
   plotText( num,
             16,           // font size
             true,         // centered,
             250, iTop+30, //
-            0.0f,         // angle
             &color,
             getColor( "defaultTxtBg" ) );
+}
+
+
+// sample every gradient once per table entry, at the middle
+// of the range each entry stands for, so the ends of the
+// scale are never sampled exactly
+void SC2Map::bakeGradients()
+{
+  if( gradientsBaked )
+  {
+    return;
+  }
+
+  const char* opennessNames[NUM_OPENNESS_LUTS] =
+  {
+    "opennessLow",
+    "opennessMid",
+    "opennessHigh",
+  };
+
+  for( int i = 0; i < GRADIENT_LUT_SIZE; ++i )
+  {
+    float zeroToOne = ((float)i + 0.5f) / (float)GRADIENT_LUT_SIZE;
+
+    for( int l = 0; l < NUM_OPENNESS_LUTS; ++l )
+    {
+      string colorBaseName( opennessNames[l] );
+
+      gradient( zeroToOne,
+                rc.numOpennessGradientColors,
+                &colorBaseName,
+                &(opennessLUT[l][i]) );
+    }
 
-  renderTerrain();
-  renderOpenness( PATH_GROUND_WITHROCKS );
-  renderDestructs();
-  renderLoSBs();
-  renderResources();
-  renderStartLocs();
-  renderFooter();
-  img->close();
+    // the heat map is only shaded in blend mode
+    // 2, any other mode leaves the cells black
+    if( rc.influenceHeatMapBlendMode == 2 )
+    {
+      gradientNoBlend( zeroToOne,
+                       rc.influenceHeatMapRepeat,
+                       &(rc.influence1),
+                       &(rc.influence2),
+                       &(rc.influence3),
+                       &(heatMapLUT[i]) );
+    } else {
+      heatMapLUT[i] = Color( 0.0f, 0.0f, 0.0f );
+    }
+
+    Canvas::toRGB8( &(heatMapLUT[i]), heatMapRGB[i] );
+  }
+
+  gradientsBaked = true;
 }
 
 
 void SC2Map::renderOpenness( PathType t )
 {
-  for( int pci = 0; pci < cxDimPlayable; ++pci )
+  bakeGradients();
+
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
   {
-    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
     {
-      point c;
-      c.pcSet( pci, pcj );
-      plotOpenness( &c, t );
+      plotOpenness( cell( pci, pcj ), t );
     }
   }
 }
 
 
-void SC2Map::plotOpenness( point* c, PathType t )
+void SC2Map::plotOpenness( cell c, PathType t )
 {
   Color color;
+  opennessColor( c, t, &color );
+  plotCellPoint( c, &color );
+}
+
 
-  if( !checkHasOpenness( c, t ) ) {
-    color.r = 0.0f;
-    color.g = 0.0f;
-    color.b = 0.0f;
+void SC2Map::opennessColor( cell c, PathType t, Color* color )
+{
+  float openness = mapOpenness[t].at( c.pcx, c.pcy );
+
+  if( openness < -0.5f ) {
+    color->r = 0.0f;
+    color->g = 0.0f;
+    color->b = 0.0f;
 
   } else {
 
-    float openness = getOpenness( c, t );
-    //openness2color( openness, &color );
-    
-    string colorBaseName = "openness";
-    
-    // iGrok's
-    //float n = openness / getfConstant( "opennessRenderMax" );
-    
-    
+    // iGrok's scheme, a gradient per cliff level
+    int lut = OPENNESS_LUT_HIGH;
+
     switch( getHeightCell( c ) ) {
-    
+
       case 0x0:
-      case 0x1: {
-        //Color* tint = getColor( "opennessTerrainLowTint" );    
-        //color.r += tint->r;
-        //color.g += tint->g;
-        //color.b += tint->b;
-        //alterSaturation( getfConstant( "opennessElevLowSaturation" ), &color );
-        //mixWith( &color, getColor( "opennessTerrainLowTint" ) );
-        //color.r = 32.0f + 160.0f * n;
-        //color.g = 32.0f +  96.0f * n;
-        //color.b = 32.0f +  96.0f * n;
-        colorBaseName.append( "Low" );
-      } break;
-
-      case 0x2: {
-        //Color* tint = getColor( "opennessTerrainLowTint" );    
-        //color.r += tint->r;
-        //color.g += tint->g;
-        //color.b += tint->b;
-        //alterSaturation( getfConstant( "opennessElevLowSaturation" ), &color );
-        //color.r = 32.0f +  96.0f * n;
-        //color.g = 32.0f + 160.0f * n;
-        //color.b = 32.0f +  96.0f * n;
-        colorBaseName.append( "Mid" );
-      } break;
-
-      case 0x3: {
-        //Color* tint = getColor( "opennessTerrainHighTint" );    
-        //color.r += tint->r;
-        //color.g += tint->g;
-        //color.b += tint->b;
-        //alterSaturation( getfConstant( "opennessElevHighSaturation" ), &color );
-        //mixWith( &color, getColor( "opennessTerrainHighTint" ) );
-        //color.r = 32.0f +  96.0f * n;
-        //color.g = 32.0f +  96.0f * n;
-        //color.b = 32.0f + 160.0f * n;
-        colorBaseName.append( "High" );
-      } break;
+      case 0x1: lut = OPENNESS_LUT_LOW;  break;
+      case 0x2: lut = OPENNESS_LUT_MID;  break;
+      case 0x3: lut = OPENNESS_LUT_HIGH; break;
     }
-    
-    gradient( openness / getfConstant( "opennessRenderMax" ),
-              getiConstant( "numOpennessGradientColors" ),
-              &colorBaseName,
-              &color );
-  }
 
-  //color.r /= 256.0f;
-  //color.g /= 256.0f;
-  //color.b /= 256.0f;
-  
-  
-  
-  
-  plotCellPoint( c, &color );
+    *color = *lookupGradient( opennessLUT[lut],
+                              openness / rc.opennessRenderMax );
+  }
 }
 
 
@@ -758,73 +1190,12 @@ void SC2Map::openness2color( float opennessIn,
 
 
 
-void SC2Map::renderImageSummary() {
-
-  resetPNGWriter( "-summary",
-                  20, 20, // borders left right
-                  86,     // border top
-                  iFooterHeight );   // border bottom
-
-  char title[2*FILENAME_LENGTH];
-  sprintf( title,
-           "%s - Summary",
-           mapName.data() );
-
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+48, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
-
-  sprintf( title,
-           "Avg. Openness: %.2f,  Watchtower Coverage: %.1f%%",
-           opennessAvg[PATH_GROUND_WITHROCKS],
-           100.0f * watchtowerCoverage );
-
-  plotText( title,
-            18,          // font size
-            false,       // centered,
-            20, iTop+24, // bottom-left
-            0.0f,        // angle
-            getColor( "defaultTxtFg" ),
-            getColor( "defaultTxtBg" ) );
-
-
-  renderOpenness( PATH_GROUND_WITHROCKS );
-  //renderTerrain();
-  renderResources();
-  renderDestructs();
-  renderLoSBs();
-  renderChokes();
-  renderBases();
-  renderSpaceInMain();
-  renderWatchtowers();
-  renderFooter();
-  img->close();
-}
-
-
 void SC2Map::renderImagesInfluenceHeatMap()
 {
-  for( list<StartLoc*>::const_iterator itr1 = startLocs.begin();
-       itr1 != startLocs.end();
-       ++itr1 )
-  {
-    StartLoc* sl1 = *itr1;
-
-    list<StartLoc*>::const_iterator itr2 = itr1;
-    ++itr2;
-    for( ;
-         itr2 != startLocs.end();
-         ++itr2 )
-    {
-      StartLoc* sl2 = *itr2;
+  prepRenderWorkers();
+  bakeInfluenceFields();
 
-      renderImageInfluenceHeatMap( sl1, sl2 );
-    }
-  }
+  renderPairs( &SC2Map::renderImageInfluenceHeatMap );
 }
 
 
@@ -834,11 +1205,11 @@ void SC2Map::renderImageInfluenceHeatMap( StartLoc* sl1,
   char filename[FILENAME_LENGTH];
   sprintf( filename, "-influence-heatmap-%d-%d", sl1->idNum, sl2->idNum );
 
-  resetPNGWriter( filename,
-                  20, 20,       // borders: left, right
-                  58,          // border: top
-                  iFooterHeight // border: bottom
-                  );
+  resetCanvas( filename,
+               20, 20,       // borders: left, right
+               58,          // border: top
+               iFooterHeight // border: bottom
+               );
 
   int textOffset = 20;
 
@@ -853,7 +1224,6 @@ void SC2Map::renderImageInfluenceHeatMap( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+20, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -868,7 +1238,6 @@ void SC2Map::renderImageInfluenceHeatMap( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+20, // bottom-left
-            0.0f,        // angle
             getColor( "influenceLoc1" ),
             getColor( "defaultTxtBg" ) );
 
@@ -881,7 +1250,6 @@ void SC2Map::renderImageInfluenceHeatMap( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+20, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -896,116 +1264,151 @@ void SC2Map::renderImageInfluenceHeatMap( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+20, // bottom-left
-            0.0f,        // angle
             getColor( "influenceLoc2" ),
             getColor( "defaultTxtBg" ) );
 
-  renderTerrain();
+  pasteTerrain();
   renderInfluenceHeatMap( sl1, sl2 );
-  renderDestructs();
-  renderLoSBs();
-  renderResources();
+  pasteStaticObjects();
   renderInfluence( sl1, sl2 );
   plotStartLoc( sl1, getColor( "influenceLoc1" ) );
   plotStartLoc( sl2, getColor( "influenceLoc2" ) );
   renderFooter();
-  img->close();
+  img->close( &(rc.pngProfile) );
 }
 
 
-void SC2Map::renderInfluenceHeatMap( StartLoc* sl1,
-                                     StartLoc* sl2 )
+// each start location's weighted influence distance to every
+// playable cell goes in a field of its own, one job per start
+// location, so a pair's heat map only has to compare two fields
+void SC2Map::bakeInfluenceFields()
 {
-  for( int pci = 0; pci < cxDimPlayable; ++pci )
+  if( influenceFieldsBaked )
   {
-    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+    return;
+  }
+
+  influenceFields.resize( numStartLocs*cxDimPlayable*cyDimPlayable );
+
+  influenceFieldLocs.assign( numStartLocs, NULL );
+  for( list<StartLoc*>::const_iterator itr = startLocs.begin();
+       itr != startLocs.end();
+       ++itr )
+  {
+    influenceFieldLocs[(*itr)->index] = *itr;
+  }
+
+  renderPool->run( numStartLocs, &bakeInfluenceFieldJob, this );
+
+  influenceFieldsBaked = true;
+}
+
+
+void SC2Map::bakeInfluenceFieldJob( void* context, int job, int )
+{
+  SC2Map* sc2map = (SC2Map*)context;
+
+  StartLoc* sl    = sc2map->influenceFieldLocs[job];
+  float*    field = sc2map->influenceField( sl );
+
+  for( int pcj = 0; pcj < sc2map->cyDimPlayable; ++pcj )
+  {
+    for( int pci = 0; pci < sc2map->cxDimPlayable; ++pci )
     {
       point c;
-      c.pcSet( pci, pcj );
-      plotInfluenceHeatMap( &c, sl1, sl2 );
+      c.pcSet( &(sc2map->frame), pci, pcj );
+      field[pcj*sc2map->cxDimPlayable + pci] =
+        sc2map->weightedInfluenceDistance( sl, NULL, &c );
     }
   }
 }
 
 
-void SC2Map::plotInfluenceHeatMap( point*    c,
-                                   StartLoc* sl1,
-                                   StartLoc* sl2 )
+// a pass over the two start locations' fields a row of cells
+// at a time: the influence and its table entry for the whole
+// row first, in a plain loop over the arrays the compiler can
+// vectorize, then the colors are copied out into a pixel row
+void SC2Map::renderInfluenceHeatMap( StartLoc* sl1,
+                                     StartLoc* sl2 )
 {
-  float d1 = weightedInfluenceDistance( sl1, NULL, c );
-  float d2 = weightedInfluenceDistance( sl2, NULL, c );
+  bakeGradients();
 
-  float dTotal   = d1 + d2;
-  float dAverage = 0.5f * dTotal;
-  float pNeutral = 0.5f;
+  int rowLen = cxDimPlayable*iDimT;
 
-  float pInfl = pNeutral + ((dAverage - d1) / dTotal);
+  vector<int> lutIndices( cxDimPlayable );
+  vector<u8>  pixels( 3*rowLen );
+  u8*         row = &(pixels[0]);
 
-  Color color;
+  u8 black[3] = { 0, 0, 0 };
 
-  if( !getPathing( c, PATH_GROUND_NOROCKS ) )
-  {
-    color.r = 0.0f;
-    color.g = 0.0f;
-    color.b = 0.0f;
-  } else {
+  const float* field1 = influenceField( sl1 );
+  const float* field2 = influenceField( sl2 );
 
-    if( getiConstant( "influenceHeatMapBlendMode" ) == 2 ) {
-      gradientNoBlend( pInfl,
-                       getiConstant( "influenceHeatMapRepeat" ),
-                       getColor( "influence1" ),
-                       getColor( "influence2" ),
-                       getColor( "influence3" ),
-                       &color );
-    } else {
-      /*
-      gradient( pInfl,
-                getiConstant( "influenceHeatMapRepeat" ),
-                getColor( "influence1" ),
-                getColor( "influence2" ),
-                getColor( "influence3" ),
-                &color );
-      */
-    }
-  }
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+  {
+    const float* d1s = field1 + pcj*cxDimPlayable;
+    const float* d2s = field2 + pcj*cxDimPlayable;
+    int*         is  = &(lutIndices[0]);
 
-  plotCellPoint( c, &color );
-}
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
+    {
+      float d1 = d1s[pci];
+      float d2 = d2s[pci];
 
+      float dTotal   = d1 + d2;
+      float dAverage = 0.5f * dTotal;
+      float pNeutral = 0.5f;
 
+      float pInfl = pNeutral + ((dAverage - d1) / dTotal);
 
-void SC2Map::renderImagesInfluence()
-{
-  for( list<StartLoc*>::const_iterator itr1 = startLocs.begin();
-       itr1 != startLocs.end();
-       ++itr1 )
-  {
-    StartLoc* sl1 = *itr1;
+      // the same clamp as lookupGradient()
+      int i = (int)(pInfl * (float)GRADIENT_LUT_SIZE);
+      i = i < 0                   ? 0                   : i;
+      i = i > GRADIENT_LUT_SIZE-1 ? GRADIENT_LUT_SIZE-1 : i;
+      is[pci] = i;
+    }
 
-    list<StartLoc*>::const_iterator itr2 = itr1;
-    ++itr2;
-    for( ;
-         itr2 != startLocs.end();
-         ++itr2 )
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
     {
-      StartLoc* sl2 = *itr2;
+      u8* rgb = mapPathing[PATH_GROUND_NOROCKS].get( pci, pcj ) ?
+                heatMapRGB[is[pci]] : black;
+
+      for( u8* p = row + 3*iDimT*pci; p < row + 3*iDimT*(pci + 1); p += 3 )
+      {
+        p[0] = rgb[0];
+        p[1] = rgb[1];
+        p[2] = rgb[2];
+      }
+    }
+
+    int x0 = ix2png( 0 );
+    int y0 = iy2png( iDimT*pcj );
 
-      renderImageInfluence( sl1, sl2 );
+    for( int y = y0; y < y0 + iDimT; ++y )
+    {
+      img->copyRow( x0, y, rowLen, row );
     }
   }
 }
 
+
+
+void SC2Map::renderImagesInfluence()
+{
+  renderPairs( &SC2Map::renderImageInfluence );
+}
+
 void SC2Map::renderImageInfluence( StartLoc* sl1,
                                    StartLoc* sl2 )
 {
   char filename[FILENAME_LENGTH];
   sprintf( filename, "-influence-%d-%d", sl1->idNum, sl2->idNum );
 
-  resetPNGWriter( filename,
-                  20, 20,       // borders: left, right
-                  126,          // border: top
-                  iFooterHeight // border: bottom
-                  );
+  resetCanvas( filename,
+               20, 20,       // borders: left, right
+               126,          // border: top
+               iFooterHeight // border: bottom
+               );
 
   int textOffset = 20;
 
@@ -1020,7 +1423,6 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+76, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -1035,7 +1437,6 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+76, // bottom-left
-            0.0f,        // angle
             getColor( "influenceLoc1" ),
             getColor( "defaultTxtBg" ) );
 
@@ -1048,7 +1449,6 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+76, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -1063,7 +1463,6 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
             18,          // font size
             false,       // centered,
             textOffset, iTop+76, // bottom-left
-            0.0f,        // angle
             getColor( "influenceLoc2" ),
             getColor( "defaultTxtBg" ) );
 
@@ -1071,15 +1470,14 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
   sprintf( text,
            "Positional Balance, by resources: %s(%.1f%%) vs %s(%.1f%%)",
            sl1->name,
-           sl1->sl2percentBalancedByResources[sl2],
+           sl2percentBalancedByResources[slPair( sl1, sl2 )],
            sl2->name,
-           sl2->sl2percentBalancedByResources[sl1] );
+           sl2percentBalancedByResources[slPair( sl2, sl1 )] );
 
   plotText( text,
             18,          // font size
             false,       // centered,
             20, iTop+48, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
@@ -1087,29 +1485,26 @@ void SC2Map::renderImageInfluence( StartLoc* sl1,
   sprintf( text,
            "Positional Balance, by openness: %s(%.1f%%) vs %s(%.1f%%)",
            sl1->name,
-           sl1->sl2percentBalancedByOpenness[sl2],
+           sl2percentBalancedByOpenness[slPair( sl1, sl2 )],
            sl2->name,
-           sl2->sl2percentBalancedByOpenness[sl1] );
+           sl2percentBalancedByOpenness[slPair( sl2, sl1 )] );
 
   plotText( text,
             18,          // font size
             false,       // centered,
             20, iTop+20, // bottom-left
-            0.0f,        // angle
             getColor( "defaultTxtFg" ),
             getColor( "defaultTxtBg" ) );
 
 
-  renderTerrain();
+  pasteTerrain();
   renderOpenness( PATH_GROUND_WITHROCKS );
-  renderDestructs();
-  renderLoSBs();
-  renderResources();
+  pasteStaticObjects();
   renderInfluence( sl1, sl2 );
   plotStartLoc( sl1, getColor( "influenceLoc1" ) );
   plotStartLoc( sl2, getColor( "influenceLoc2" ) );
   renderFooter();
-  img->close();
+  img->close( &(rc.pngProfile) );
 }
 
 
@@ -1120,11 +1515,8 @@ void SC2Map::renderInfluence( StartLoc* sl1, StartLoc* sl2 ) {
   {
     Base* b = *itr;
 
-    map<StartLoc*, float>* innerMap = b->sl1vsl2_influence[sl1];
-    float infl1 = (*innerMap)[sl2];
-
-    innerMap = b->sl1vsl2_influence[sl2];
-    float infl2 = (*innerMap)[sl1];
+    float infl1 = sl1vsl2_influence[baseSLPair( b, sl1, sl2 )];
+    float infl2 = sl1vsl2_influence[baseSLPair( b, sl2, sl1 )];
 
     char strInfl[64];
 
@@ -1138,7 +1530,6 @@ void SC2Map::renderInfluence( StartLoc* sl1, StartLoc* sl2 ) {
                 18,          // font size
                 true,       // centered,
                 ix2png( b->loc.ix ), iy2png( b->loc.iy ),
-                0.0f,        // angle
                 getColor( "influenceLoc1" ),
                 getColor( "defaultTxtBg" ) );
     } else {
@@ -1150,7 +1541,6 @@ void SC2Map::renderInfluence( StartLoc* sl1, StartLoc* sl2 ) {
                 18,          // font size
                 true,       // centered,
                 ix2png( b->loc.ix ), iy2png( b->loc.iy ),
-                0.0f,        // angle
                 getColor( "influenceLoc2" ),
                 getColor( "defaultTxtBg" ) );
     }
@@ -1161,13 +1551,103 @@ void SC2Map::renderInfluence( StartLoc* sl1, StartLoc* sl2 ) {
 
 
 
+// the terrain and the objects that never move look the same in
+// every image, so draw each once into a layer and paste it
+void SC2Map::pasteTerrain()
+{
+  bakeLayers();
+  img->paste( iLeft - iLayerMargin, iBottom - iLayerMargin, &terrainLayer );
+}
+
+
+void SC2Map::pasteStaticObjects()
+{
+  bakeLayers();
+  img->paste( iLeft - iLayerMargin, iBottom - iLayerMargin, &staticObjectsLayer );
+}
+
+
+void SC2Map::renderStaticObjects()
+{
+  renderDestructs();
+  renderLoSBs();
+  renderResources();
+}
+
+
+void SC2Map::bakeLayers()
+{
+  if( layersBaked )
+  {
+    return;
+  }
+
+  // the layers are drawn by the usual render functions into
+  // scratch canvases framed like an image, with a margin
+  // instead of borders, so point the frame at them for now
+  Canvas* imgSaved     = img;
+  int     iLeftSaved   = iLeft;
+  int     iBottomSaved = iBottom;
+  int     iRightSaved  = iRight;
+  int     iTopSaved    = iTop;
+
+  iLeft   = iLayerMargin;
+  iBottom = iLayerMargin;
+  iRight  = iLeft   + txDimPlayable*iDimT;
+  iTop    = iBottom + tyDimPlayable*iDimT;
+
+  Canvas onBlack;
+  Canvas onWhite;
+  onBlack.resize( iRight + iLayerMargin, iTop + iLayerMargin );
+  onWhite.resize( iRight + iLayerMargin, iTop + iLayerMargin );
+
+  Color black( 0.0f, 0.0f, 0.0f );
+  Color white( 1.0f, 1.0f, 1.0f );
+
+  void (SC2Map::*draws[])() =
+  {
+    &SC2Map::renderTerrain,
+    &SC2Map::renderStaticObjects,
+  };
+  Layer* layers[] =
+  {
+    &terrainLayer,
+    &staticObjectsLayer,
+  };
+
+  for( int i = 0; i < getArrLength( layers ); ++i )
+  {
+    onBlack.fill( &black );
+    onWhite.fill( &white );
+
+    img = &onBlack;
+    (this->*draws[i])();
+
+    img = &onWhite;
+    (this->*draws[i])();
+
+    layers[i]->capture( &onBlack, &onWhite );
+  }
+
+  img     = imgSaved;
+  iLeft   = iLeftSaved;
+  iBottom = iBottomSaved;
+  iRight  = iRightSaved;
+  iTop    = iTopSaved;
+
+  layersBaked = true;
+}
+
+
 void SC2Map::renderTerrain() {
+  bakeStamps();
+
   for( int pti = 0; pti < txDimPlayable; ++pti )
   {
     for( int ptj = 0; ptj < tyDimPlayable; ++ptj )
     {
       point t;
-      t.ptSet( pti, ptj );
+      t.ptSet( &frame, pti, ptj );
       plotTerrain( &t );
     }
   }
@@ -1199,9 +1679,7 @@ void SC2Map::plotTerrain( point* t ) {
     } break;
     
     case 0x1: {
-      plotTerrainPoint( t, 
-                        iTerrain1IconPoints, getArrLength( iTerrain1IconPoints ),
-                        getColor( "terrainElev1" ) );
+      plotTerrainPoint( t, &stampTerrain1 );
     } break;
     
     case 0x2: {
@@ -1212,35 +1690,18 @@ void SC2Map::plotTerrain( point* t ) {
     } break;
     
     case 0x3: {
-      plotTerrainPoint( t, 
-                        iTerrain3IconPoints, getArrLength( iTerrain3IconPoints ),
-                        getColor( "terrainElev3" ) );
+      plotTerrainPoint( t, &stampTerrain3 );
     } break;
   }  
 }
-void SC2Map::plotTerrainPoint( point* t, 
-                               int* iPoints, int numPoints,
-                               Color* color ) {
-                               
+void SC2Map::plotTerrainPoint( point* t, Stamp* stamp ) {
+
   // get the bottom-left corner of the cell
   // in output PNG pixels
   int x0 = ix2png( t->ix - iDimC/2 );
   int y0 = iy2png( t->iy - iDimC/2 );
 
-  for( int i = 0; i < numPoints; i = i + 2 ) {
-    img->plot( x0 + iPoints[i], 
-               y0 + iPoints[i + 1],
-               color->r, color->g, color->b );
-  }
-  
-  /*
-  img->filledsquare( x0 + 2,
-                     y0 + 2,
-                     x0 + 3,
-                     y0 + 3,
-                     color->r, color->g, color->b
-                   );
-  */
+  img->blit( x0, y0, stamp );
 }
 
 
@@ -1248,13 +1709,22 @@ void SC2Map::plotTerrainPoint( point* t,
 
 void SC2Map::renderPathing( PathType t )
 {
-  for( int pci = 0; pci < cxDimPlayable; ++pci )
+  Color* clear   = &(rc.pathingClear  );
+  Color* blocked = &(rc.pathingBlocked);
+
+  // pull runs of same-valued cells out of the pathing
+  // plane's words and fill each run as one rectangle
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
   {
-    for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+    int pci = 0;
+    while( pci < cxDimPlayable )
     {
-      point c;
-      c.pcSet( pci, pcj );
-      plotPathing( &c, t );
+      int pciEnd = mapPathing[t].runEnd( pci, pcj );
+
+      plotCellSpan( pci, pciEnd - 1, pcj,
+                    mapPathing[t].get( pci, pcj ) ? clear : blocked );
+
+      pci = pciEnd;
     }
   }
 }
@@ -1265,9 +1735,9 @@ void SC2Map::plotPathing( point* c, PathType t )
 
   if( getPathing( c, t ) )
   {
-    color = getColor( "pathingClear" );
+    color = &(rc.pathingClear);
   } else {
-    color = getColor( "pathingBlocked" );
+    color = &(rc.pathingBlocked);
   }
 
   plotCellPoint( c, color );
@@ -1276,6 +1746,8 @@ void SC2Map::plotPathing( point* c, PathType t )
 
 
 void SC2Map::renderDestructs() {
+  bakeStamps();
+
   for( list<Destruct*>::const_iterator itr = destructs.begin();
        itr != destructs.end();
        ++itr )
@@ -1288,14 +1760,7 @@ void SC2Map::plotDestruct( point* p ) {
   int x0 = ix2png( p->ix - iDimT/2 );
   int y0 = iy2png( p->iy - iDimT/2 );
 
-  Color* color = getColor( "destruct" );
-
-  img->filledsquare( x0,
-                     y0,
-                     x0 + iDimT - 1,
-                     y0 + iDimT - 1,
-                     color->r, color->g, color->b
-                   );
+  img->blit( x0, y0, &stampDestruct );
 }
 
 
@@ -1318,35 +1783,35 @@ void SC2Map::plotLoSB( point* p ) {
              y0,
              x0 + iDimT - 1,
              y0 + iDimT - 1,
-             color->r, color->g, color->b
+             color
            );
 
   img->line( x0,
              y0 + 3,
              x0 + iDimT - 1 - 3,
              y0 + iDimT - 1,
-             color->r, color->g, color->b
+             color
            );
 
   img->line( x0,
              y0 + 6,
              x0 + iDimT - 1 - 6,
              y0 + iDimT - 1,
-             color->r, color->g, color->b
+             color
            );
 
   img->line( x0 + 3,
              y0,
              x0 + iDimT - 1,
              y0 + iDimT - 1 - 3,
-             color->r, color->g, color->b
+             color
            );
 
   img->line( x0 + 6,
              y0,
              x0 + iDimT - 1,
              y0 + iDimT - 1 - 6,
-             color->r, color->g, color->b
+             color
            );
 }
 
@@ -1376,7 +1841,6 @@ void SC2Map::plotChoke( point* p,
             12,         // font size
             true,       // centered,
             x0, y0,
-            0.0f,        // angle
             color,
             getColor( "defaultTxtBg" ) );
 }
@@ -1425,11 +1889,11 @@ void SC2Map::plotMineralField( point* p, bool highYield ) {
   int x0 = ix2png( p->ix - iDimT   );
   int y0 = iy2png( p->iy - iDimT/2 );
 
-  img->filledsquare( x0,
+  img->filledSquare( x0,
                      y0,
                      x0 + 2*iDimT - 1,
                      y0 +   iDimT - 1,
-                     color->r, color->g, color->b
+                     color
                    );
 }
 void SC2Map::plotGeyser( point* p, bool highYield ) {
@@ -1444,11 +1908,11 @@ void SC2Map::plotGeyser( point* p, bool highYield ) {
   int x0 = ix2png( p->ix - 3*(iDimT/2) );
   int y0 = iy2png( p->iy - 3*(iDimT/2) );
 
-  img->filledsquare( x0,
+  img->filledSquare( x0,
                      y0,
                      x0 + 3*iDimT - 1,
                      y0 + 3*iDimT - 1,
-                     color->r, color->g, color->b
+                     color
                    );
 }
 
@@ -1456,6 +1920,8 @@ void SC2Map::plotGeyser( point* p, bool highYield ) {
 
 void SC2Map::renderWatchtowers()
 {
+  bakeStamps();
+
   for( list<Watchtower*>::const_iterator itr = watchtowers.begin();
        itr != watchtowers.end();
        ++itr )
@@ -1487,32 +1953,55 @@ void SC2Map::plotWatchtower( Watchtower* wt ) {
   img->circle( ix2png( wt->loc.ix ),
                iy2png( wt->loc.iy ),
                iDimT * (int)wt->range,
-               color->r, color->g, color->b );
+               color );
 
   int x0 = ix2png( wt->loc.ix - iDimT );
   int y0 = iy2png( wt->loc.iy - iDimT );
 
-  color = getColor( "watchTowerBg" );
-  img->filledsquare( x0,
-                     y0,
-                     x0 + 2*iDimT - 1,
-                     y0 + 2*iDimT - 1,
-                     color->r, color->g, color->b
-                   );
+  img->blit( x0, y0, &stampWatchtower );
+}
 
-  color = getColor( "watchTowerFg" );
-  //img->filledsquare( x0,
-  //                   y0,
-  //                   x0 + 2*iDimT - 1,
-  //                   y0 + 2*iDimT - 1,
-  //                   color->r, color->g, color->b
-  //                 );
-  
+
+
+// the terrain marks, destructibles and the watchtower icon
+// look the same everywhere, so render each one once into a
+// stamp and blit the stamps instead of plotting pixels
+void SC2Map::bakeStamps()
+{
+  if( stampsBaked )
+  {
+    return;
+  }
+
+  stampTerrain1.clear( iDimC, iDimC );
+  for( int i = 0; i < getArrLength( iTerrain1IconPoints ); i = i + 2 ) {
+    stampTerrain1.set( iTerrain1IconPoints[i],
+                       iTerrain1IconPoints[i + 1],
+                       &(rc.terrainElev1) );
+  }
+
+  stampTerrain3.clear( iDimC, iDimC );
+  for( int i = 0; i < getArrLength( iTerrain3IconPoints ); i = i + 2 ) {
+    stampTerrain3.set( iTerrain3IconPoints[i],
+                       iTerrain3IconPoints[i + 1],
+                       &(rc.terrainElev3) );
+  }
+
+  stampDestruct.clear( iDimT, iDimT );
+  stampDestruct.fill( getColor( "destruct" ) );
+
+  // the tower icon points are in bitmap rows, flip them
+  stampWatchtower.clear( 2*iDimT, 2*iDimT );
+  stampWatchtower.fill( getColor( "watchTowerBg" ) );
+
+  Color* color = getColor( "watchTowerFg" );
   for( int i = 0; i < getArrLength( ibTowerIconPoints ); i = i + 2 ) {
-    img->plot( x0 +               ibTowerIconPoints[i], 
-               y0 + 2*iDimT - 1 - ibTowerIconPoints[i + 1],
-               color->r, color->g, color->b );
+    stampWatchtower.set( ibTowerIconPoints[i],
+                         2*iDimT - 1 - ibTowerIconPoints[i + 1],
+                         color );
   }
+
+  stampsBaked = true;
 }
 
 
@@ -1533,18 +2022,18 @@ void SC2Map::plotStartLoc( StartLoc* sl, Color* color )
   int x0 = ix2png( sl->loc.ix - 5*(iDimT/2) );
   int y0 = iy2png( sl->loc.iy - 5*(iDimT/2) );
 
-  img->filledsquare( x0,
+  Color white( 1.0f, 1.0f, 1.0f );
+  img->filledSquare( x0,
                      y0,
                      x0 + 5*iDimT - 1,
                      y0 + 5*iDimT - 1,
-                     1.0f, 1.0f, 1.0f
+                     &white
                    );
 
   plotText( sl->name, 18,
             true,               // centered
             ix2png( sl->loc.ix ),
             iy2png( sl->loc.iy ),
-            0.0f,               // angle
             color,
             getColor( "defaultTxtBg" ) );
 }
@@ -1650,7 +2139,6 @@ void SC2Map::plotBaseInformation( Base* base ) {
                       18,
                       true,
                       icenterx, icentery,
-                      0.0f,
                       (Color**)fores,
                       (Color**)backs );
   
@@ -1740,7 +2228,6 @@ void SC2Map::plotBaseInformation( Base* base ) {
                       16,
                       true,
                       icenterx, icentery,
-                      0.0f,
                       (Color**)fores,
                       (Color**)backs );
 
@@ -1765,8 +2252,8 @@ void SC2Map::plotBaseDebugInformation( Base* base ) {
   Color* color = getColor( "debugBaseOpennessNeighborhoodRadius" );
   img->circle( ix2png( base->loc.ix ),
                iy2png( base->loc.iy ),
-               iDimT * (int)getfConstant( "baseAvgOpennessNeighborhoodRadius" ),
-               color->r, color->g, color->b );
+               iDimT * (int)rc.baseAvgOpennessNeighborhoodRadius,
+               color );
 
 
   // point from a base to the start location it "belongs to"
@@ -1791,11 +2278,11 @@ void SC2Map::plotBaseDebugInformation( Base* base ) {
   // draw arrow pointing to resource patches that
   // belong to this base, from the base's center
   color = getColor( "debugBaseArrowsToResources" );
-  img->filledsquare( x0,
+  img->filledSquare( x0,
                      y0,
                      x0 + iDimT - 1,
                      y0 + iDimT - 1,
-                     color->r, color->g, color->b
+                     color
                    );
 
   for( list<Resource*>::const_iterator itr = base->resources.begin();
@@ -1844,45 +2331,85 @@ void SC2Map::plotCellPoint( point* c, Color* color )
   // do most of the thing as a rectangle--remember
   // pngwriter plots the inclsive rectangle, so subtract
   // one from the top and right coordinates
-  img->filledsquare( x0 + 1,
+  img->filledSquare( x0 + 1,
                      y0 + 1,
                      x0 + iDimT - 2,
                      y0 + iDimT - 2,
-                     color->r, color->g, color->b
+                     color
                    );
 
   // then plot the 8 pixels that stick out of the
   // four sides of the bigger rectable
-  img->plot( x0,             y0 + 3,         color->r, color->g, color->b );
-  img->plot( x0,             y0 + 4,         color->r, color->g, color->b );
-  img->plot( x0 + iDimT - 1, y0 + 3,         color->r, color->g, color->b );
-  img->plot( x0 + iDimT - 1, y0 + 4,         color->r, color->g, color->b );
-  img->plot( x0 + 3,         y0,             color->r, color->g, color->b );
-  img->plot( x0 + 4,         y0,             color->r, color->g, color->b );
-  img->plot( x0 + 3,         y0 + iDimT - 1, color->r, color->g, color->b );
-  img->plot( x0 + 4,         y0 + iDimT - 1, color->r, color->g, color->b );
+  img->plot( x0,             y0 + 3,         color );
+  img->plot( x0,             y0 + 4,         color );
+  img->plot( x0 + iDimT - 1, y0 + 3,         color );
+  img->plot( x0 + iDimT - 1, y0 + 4,         color );
+  img->plot( x0 + 3,         y0,             color );
+  img->plot( x0 + 4,         y0,             color );
+  img->plot( x0 + 3,         y0 + iDimT - 1, color );
+  img->plot( x0 + 4,         y0 + iDimT - 1, color );
   */
 
   /*
-  img->filledsquare( x0,
+  img->filledSquare( x0,
                      y0 + 1,
                      x0 + iDimT - 1,
                      y0 + iDimT - 2,
-                     color->r, color->g, color->b
+                     color
                    );
 
-  img->filledsquare( x0 + 1,
+  img->filledSquare( x0 + 1,
                      y0,
                      x0 + iDimT - 2,
                      y0 + iDimT - 1,
-                     color->r, color->g, color->b
+                     color
                    );
   */
-  img->filledsquare( x0,
+  img->filledSquare( x0,
                      y0,
                      x0 + iDimT - 1,
                      y0 + iDimT - 1,
-                     color->r, color->g, color->b
+                     color
+                   );
+}
+
+
+
+
+// fill the cells pcx0 through pcx1, inclusive, of
+// one row of cells with a single rectangle
+void SC2Map::plotCellSpan( int pcx0, int pcx1, int pcy, Color* color )
+{
+  point c0; c0.pcSet( &frame, pcx0, pcy );
+  point c1; c1.pcSet( &frame, pcx1, pcy );
+
+  int x0 = ix2png( c0.ix - iDimT/2 );
+  int y0 = iy2png( c0.iy - iDimT/2 );
+  int x1 = ix2png( c1.ix - iDimT/2 ) + iDimT - 1;
+
+  img->filledSquare( x0,
+                     y0,
+                     x1,
+                     y0 + iDimT - 1,
+                     color
+                   );
+}
+
+
+
+// plot a cell point straight from a cell index, the
+// cell's center pixel is iDimT*pc + iDimT/2 so the
+// bottom-left corner of the square is iDimT*pc
+void SC2Map::plotCellPoint( cell c, Color* color )
+{
+  int x0 = ix2png( iDimT*c.pcx );
+  int y0 = iy2png( iDimT*c.pcy );
+
+  img->filledSquare( x0,
+                     y0,
+                     x0 + iDimT - 1,
+                     y0 + iDimT - 1,
+                     color
                    );
 }
 
@@ -1894,14 +2421,14 @@ void SC2Map::plotArrow( int x0, int y0, int x1, int y1,
 {
   if( x0 == x1 && y0 == y1 )
   {
-    // apparently if you try to plot an arrow from one
-    // point to the same point, pngwriter dies silently
+    // an arrow from a point to the same point
+    // has no direction to draw the head along
     return;
   }
 
   img->arrow( x0, y0, x1, y1,
               4, 0.4f, // size and angle of arrowhead
-              color->r, color->g, color->b );
+              color );
 }
 
 
@@ -2020,10 +2547,10 @@ void SC2Map::plotTri( int x1, int y1,
 
   }
 
-  img->filledtriangle( xa, ya,
+  img->filledTriangle( xa, ya,
                        xb, yb,
                        xc, yc,
-                       color->r, color->g, color->b );
+                       color );
 }
 
 
@@ -2031,19 +2558,16 @@ void SC2Map::plotTri( int x1, int y1,
 void SC2Map::plotText( char* text,
                        int fontsize,
                        bool centered, int ix, int iy,
-                       float angle,
                        Color* fore,
                        Color* back
                      )
 {
-  static char fontface[] = "./FreeSansBold.ttf";
-
   int x;
   int y;
 
   if( centered )
   {
-    int w = img->get_text_width( fontface, fontsize, text );
+    int w = img->getTextWidth( fontface, fontsize, text );
 
     x = ix - w/2;
     y = iy - fontsize/2;
@@ -2054,30 +2578,19 @@ void SC2Map::plotText( char* text,
     y = iy;
   }
 
-  // make a background of the text with offset plots
-  for( int i = -2; i <= 2; ++i )
-  {
-    for( int j = -2; j <= 2; ++j )
-    {
-      img->plot_text( fontface, fontsize,
-                      x + i, y + j,
-                      angle, text,
-                      back->r, back->g, back->b );
-    }
-  }
-
-  // then put foreground down
-  img->plot_text( fontface, fontsize,
-                  x, y,
-                  angle, text,
-                  fore->r, fore->g, fore->b );
+  // the background is an outline around the foreground
+  // that the canvas composites from its glyph cache
+  img->plotText( fontface, fontsize,
+                 x, y,
+                 text,
+                 fore,
+                 back );
 }
 
 
 int SC2Map::getTextWidth( char* text, int fontsize )
 {
-  char fontface[] = "./FreeSansBold.ttf";
-  return img->get_text_width( fontface, fontsize, text );
+  return img->getTextWidth( fontface, fontsize, text );
 }
 
 
@@ -2085,7 +2598,6 @@ void SC2Map::plotTextMultiColor( int numSegments,
                                  char** texts,
                                  int fontsize,
                                  bool centered, int ix, int iy,
-                                 float angle,
                                  Color** fores,
                                  Color** backs
                                ) {
@@ -2102,7 +2614,7 @@ void SC2Map::plotTextMultiColor( int numSegments,
   }
   
   for( int i = 0; i < numSegments; ++i ) {
-    plotText( texts[i], fontsize, false, iStartingX, iy, angle, fores[i], backs[i] );
+    plotText( texts[i], fontsize, false, iStartingX, iy, fores[i], backs[i] );
     iStartingX += getTextWidth( texts[i], fontsize );
   }
 }
@@ -2179,16 +2691,8 @@ void SC2Map::gradient( float   zeroToOne,
 
 
 
-int SC2Map::pngwriterTest() {
-  pngwriter test( 10, 10, 1.0f, "dummy.png" );
-
-  char fontface[] = "./FreeSansBold.ttf";
-
-  errno = 0;
-
-  test.plot_text( fontface, 10, 0, 0, 0.0f, (char*)"test", 1.0f, 1.0f, 1.0f );
-
-  return errno;
+int SC2Map::fontTest() {
+  return Canvas::fontTest( fontface );
 }
 void SC2Map::renderTestAllPaths() {
   renderTerrain();
@@ -2198,9 +2702,7 @@ void SC2Map::renderTestAllPaths() {
   plotAllShortestPaths( &(sl0->loc), PATH_GROUND_WITHROCKS );
 }
 void SC2Map::plotAllShortestPaths( point* p, PathType t ) {
-  float r = 1.0f;
-  float g = 1.0f;
-  float b = 0.0f;
+  Color color( 1.0f, 1.0f, 0.0f );
 
   Node* src = getPathNode( p, t );
 
@@ -2208,7 +2710,7 @@ void SC2Map::plotAllShortestPaths( point* p, PathType t ) {
   {
     for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
     {
-      point c; c.pcSet( pci, pcj );
+      point c; c.pcSet( &frame, pci, pcj );
       Node* u = getPathNode( &c, t );
       if( u == NULL ) { continue; }
 
@@ -2218,7 +2720,7 @@ void SC2Map::plotAllShortestPaths( point* p, PathType t ) {
       img->arrow( ix2png( u->loc.ix ), iy2png( u->loc.iy ),
                   ix2png( v->loc.ix ), iy2png( v->loc.iy ),
                   4, 0.4f,
-                  r, g, b );
+                  &color );
     }
   }
 }
@@ -2231,72 +2733,73 @@ void SC2Map::renderTestPathingFills() {
        ++itr )
   {
     point c;
-    c.pcSet( (*itr).pcx, (*itr).pcy );
+    c.pcSet( &frame, (*itr).pcx, (*itr).pcy );
 
     int x0 = ix2png( c.ix - iDimC/2 );
     int y0 = iy2png( c.iy - iDimC/2 );
 
-    img->filledsquare( x0 + 2,
+    Color cyan( 0.0f, 1.0f, 1.0f );
+    img->filledSquare( x0 + 2,
                        y0 + 2,
                        x0 + 3,
                        y0 + 3,
-                       0.0f, 1.0f, 1.0f
+                       &cyan
                      );
   }
 }
 void SC2Map::renderTestFrameTranslation() {
-  float r, g, b;
+  Color color( 0.2f, 0.2f, 0.0f );
 
-  img->filledsquare( iLeft, iBottom, iRight - 1, iTop - 1, 0.2f, 0.2f, 0.0f );
+  img->filledSquare( iLeft, iBottom, iRight - 1, iTop - 1, &color );
 
 
   renderTerrain();
 
-  r = 1.0f; g = 0.0f; b = 0.0f;
-  img->plot( ix2png( 0 ), iy2png( 0 ), r, g, b );
+  color = Color( 1.0f, 0.0f, 0.0f );
+  img->plot( ix2png( 0 ), iy2png( 0 ), &color );
   //plotText( "image frame origin", 10, true, iLeft, iBottom-10,
-  //          0.0f, r, g, b, 0.0f, 0.0f, 0.0f );
+  //          r, g, b, 0.0f, 0.0f, 0.0f );
 
   // when the map (mcLeft, mcBottom) = (26, 20) then
   // this point should appear in the center of the
   // playable cell (0, 0)
-  r = 0.0f; g = 1.0f; b = 0.0f;
-  point p1; p1.mSet( 26.5f, 20.5f );
-  img->plot( ix2png( p1.ix ), iy2png( p1.iy ), r, g, b );
+  color = Color( 0.0f, 1.0f, 0.0f );
+  point p1; p1.mSet( &frame, 26.5f, 20.5f );
+  img->plot( ix2png( p1.ix ), iy2png( p1.iy ), &color );
 
 
   // this point should appear in the center of
   // playable terrain unit (1, 2)
-  r = 0.0f; g = 0.0f; b = 1.0f;
-  point p2; p2.ptSet( 1, 2 );
-  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), r, g, b );
+  color = Color( 0.0f, 0.0f, 1.0f );
+  point p2; p2.ptSet( &frame, 1, 2 );
+  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), &color );
 
   // and playable terrain unit (2, 2)
-  p2.ptSet( 2, 2 );
-  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), r, g, b );
+  p2.ptSet( &frame, 2, 2 );
+  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), &color );
 
   // and playable terrain unit (1, 3)
-  p2.ptSet( 1, 3 );
-  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), r, g, b );
+  p2.ptSet( &frame, 1, 3 );
+  img->plot( ix2png( p2.ix ), iy2png( p2.iy ), &color );
 
 
 
   // this point should appear in the center of
   // playable cell (3, 1)
-  r = 0.0f; g = 1.0f; b = 1.0f;
-  point p3; p3.pcSet( 3, 1 );
-  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), r, g, b );
+  color = Color( 0.0f, 1.0f, 1.0f );
+  point p3; p3.pcSet( &frame, 3, 1 );
+  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), &color );
 
   // and playable cell (4, 1)
-  p3.pcSet( 4, 1 );
-  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), r, g, b );
+  p3.pcSet( &frame, 4, 1 );
+  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), &color );
 
   // and playable cell (5, 2)
-  p3.pcSet( 5, 2 );
-  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), r, g, b );
+  p3.pcSet( &frame, 5, 2 );
+  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), &color );
 
-  p3.pcSet( 0, 0 );
-  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), r, g, b );
+  p3.pcSet( &frame, 0, 0 );
+  img->plot( ix2png( p3.ix ), iy2png( p3.iy ), &color );
 }
 void SC2Map::renderTestClockFaceDetection() {
   float upperBounds[13];
@@ -2335,7 +2838,7 @@ void SC2Map::renderTestClockFaceDetection() {
   // set a point at the playable terrain's center
   // to calculate the angle to a start location
   point center;
-  center.ptSet( txDimPlayable/2,
+  center.ptSet( &frame, txDimPlayable/2,
                 tyDimPlayable/2 );
 
   for( int pci = 0; pci < cxDimPlayable; ++pci )
@@ -2343,7 +2846,7 @@ void SC2Map::renderTestClockFaceDetection() {
     for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
     {
       point c;
-      c.pcSet( pci, pcj );
+      c.pcSet( &frame, pci, pcj );
 
       float* rgb;
 
@@ -2376,16 +2879,17 @@ void SC2Map::renderTestDetectChokes() {
        ++itr )
   {
     point c;
-    c.pcSet( (*itr).pcx, (*itr).pcy );
+    c.pcSet( &frame, (*itr).pcx, (*itr).pcy );
 
     int x0 = ix2png( c.ix - iDimT/2 );
     int y0 = iy2png( c.iy - iDimT/2 );
 
-    img->filledsquare( x0,
+    Color cyan( 0.0f, 1.0f, 1.0f );
+    img->filledSquare( x0,
                        y0,
                        x0 + iDimT - 1,
                        y0 + iDimT - 1,
-                       0.0f, 1.0f, 1.0f
+                       &cyan
                      );
 
     //float ano = calculateAverageOpennessInNeighborhood( &c,
@@ -2407,44 +2911,43 @@ void SC2Map::renderTestDetectChokes() {
               18,          // font size
               true,       // centered,
               ix2png( c.ix ), iy2png( c.iy ) - 18,
-              0.0f,        // angle
               getColor( "defaultTxtFg" ),
               getColor( "defaultTxtBg" ) );
   }
 }
 void SC2Map::renderTestImages() {
-  //resetPNGWriter( "-test-frame-translation",
+  //resetCanvas( "-test-frame-translation",
   //                3, 7, // left, right borders
   //                11, 4  // top, bottom border
-  //              );
+  //           );
   //renderTestFrameTranslation();
-  //img->close();
+  //img->close( &(rc.pngProfile) );
 
-  //resetPNGWriter( "-test-clock-face-detection",
-  //                5, 5, // left, right borders
-  //                5, 5  // top, bottom border
-  //              );
+  //resetCanvas( "-test-clock-face-detection",
+  //             5, 5, // left, right borders
+  //             5, 5  // top, bottom border
+  //           );
   //renderTestClockFaceDetection();
-  //img->close();
+  //img->close( &(rc.pngProfile) );
 
-  //resetPNGWriter( "-test-all-paths",
-  //                5, 5, // left, right borders
-  //                5, 5  // top, bottom border
-  //              );
+  //resetCanvas( "-test-all-paths",
+  //             5, 5, // left, right borders
+  //             5, 5  // top, bottom border
+  //           );
   //renderTestAllPaths();
-  //img->close();
+  //img->close( &(rc.pngProfile) );
 
-  //resetPNGWriter( "-test-pathings-fills",
-  //                5, 5, // left, right borders
-  //                5, 5  // top, bottom border
-  //              );
+  //resetCanvas( "-test-pathings-fills",
+  //             5, 5, // left, right borders
+  //             5, 5  // top, bottom border
+  //           );
   //renderTestPathingFills();
-  //img->close();
+  //img->close( &(rc.pngProfile) );
 
-  //resetPNGWriter( "-test-detect-chokes",
-  //                5, 5, // left, right borders
-  //                5, 5  // top, bottom border
-  //              );
+  //resetCanvas( "-test-detect-chokes",
+  //             5, 5, // left, right borders
+  //             5, 5  // top, bottom border
+  //           );
   //renderTestDetectChokes();
-  //img->close();
+  //img->close( &(rc.pngProfile) );
 }
@@ -20,6 +20,8 @@ typedef unsigned char  u8;
 typedef unsigned short u16;
 typedef unsigned int   u32;
 
+typedef unsigned long long u64;
+
 // max length of any filenames
 #define FILENAME_LENGTH 512
 
@@ -97,6 +99,52 @@ struct Node
 
 
 
+// the path nodes a base is patched into the path graph
+// with, and how far each is from the base's true location.
+// A base gets at most one node per ray cast out from it,
+// so the entries fit in place without a tree or the heap
+#define MAX_PATCH_NODES 8
+
+struct PatchNode
+{
+  int   id;
+  float d;
+};
+
+struct PatchNodes
+{
+  PatchNodes()
+  {
+    count = 0;
+  }
+
+  // entries are kept in node ID order so ties
+  // between equally short routes always break
+  // the same way
+  void add( int id, float d )
+  {
+    if( count == MAX_PATCH_NODES )
+    {
+      return;
+    }
+
+    int i = count;
+    while( i > 0 && entries[i-1].id > id )
+    {
+      entries[i] = entries[i-1];
+      --i;
+    }
+    entries[i].id = id;
+    entries[i].d  = d;
+    ++count;
+  }
+
+  int       count;
+  PatchNode entries[MAX_PATCH_NODES];
+};
+
+
+
 // forward declaration
 struct Base;
 
@@ -107,15 +155,10 @@ struct StartLoc
   char  name[STARTLOC_NAME_LENGTH];
   int   idNum;
 
-  // when this start location spawns against
-  // another start location, the resource
-  // influence is a total of the resources of
-  // bases this location has influence over
-  // compared to that start loc
-  map<StartLoc*, float> sl2resourceInfluence;
-  map<StartLoc*, float> sl2opennessInfluence;
-  map<StartLoc*, float> sl2percentBalancedByResources;
-  map<StartLoc*, float> sl2percentBalancedByOpenness;
+  // start locations are numbered densely from 0 in
+  // the order they are read, the start location vs.
+  // start location tables in SC2Map use this index
+  int   index;
 
   Base* mainBase;
   Base* natBase;
@@ -127,6 +170,43 @@ struct StartLoc
 
   // count space in main in cells
   int spaceInMain;
+
+  // the start location this one maps onto when the
+  // map is symmetric, NULL otherwise
+  StartLoc* symmetricPartner;
+};
+
+
+
+// the symmetries a map is checked for, a map has
+// at most one of them reported even when it has
+// several (a 4-fold rotation is also a 2-fold one)
+enum SymmetryType
+{
+  SYMMETRY_NONE,
+  SYMMETRY_ROT4,
+  SYMMETRY_ROT2,
+  SYMMETRY_MIRROR_X,
+  SYMMETRY_MIRROR_Y,
+  SYMMETRY_MIRROR_DIAG,
+  SYMMETRY_MIRROR_ANTIDIAG,
+  NUM_SYMMETRY_TYPES
+};
+
+
+
+// which start locations a cell is closest to by
+// path distance, second is -1 when only one start
+// location can reach the cell at all
+struct Territory
+{
+  int   nearest;
+  int   second;
+  float dNearest;
+
+  // how much further the second start location is,
+  // infinity when there is no second one
+  float margin;
 };
 
 
@@ -168,6 +248,10 @@ struct Base {
   point    loc;
   u8       cliffLevel;
 
+  // bases are numbered densely from 0 in the
+  // order they are found, for SC2Map's tables
+  int      index;
+
   // if this base is nearer a start location,
   // which one?
   StartLoc* sl;
@@ -193,15 +277,7 @@ struct Base {
   // the distance they are from the base's true location,
   // which in some cases is over unpathable area (such as
   // a base blocked by destructible rocks)
-  map<Node*, float> node2patchDistance[NUM_PATH_TYPES];
-
-  // start loc, start loc to an influence value, it means
-  // The influence SL1 exerts on the base when spawned
-  // against SL2 in 1v1.
-  map< StartLoc*, map<StartLoc*, float>* > sl1vsl2_influence;
-
-  // for main/nat/third classification
-  map<StartLoc*, float> sl2averageInfluence;
+  PatchNodes node2patchDistance[NUM_PATH_TYPES];
 };
 
 
@@ -210,6 +286,10 @@ struct Watchtower
 {
   point loc;
   float range;
+
+  // fraction of ground pathable cells this
+  // watchtower sees on its own
+  float coverage;
 };
 
 
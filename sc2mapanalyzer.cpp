@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 using namespace std;
 
 #include <stdlib.h>
@@ -13,34 +14,60 @@ using namespace std;
 #include "utility.hpp"
 #include "config.hpp"
 #include "outstreams.hpp"
+#include "PngEncoder.hpp"
+#include "WorkerPool.hpp"
+#include "MapQueue.hpp"
 #include "SC2Map.hpp"
 #include "SC2MapAggregator.hpp"
 
 
 
-// controls set by options: defaults
+// controls set by options: defaults, the per-map
+// output options are read in outputMap for each map
 static bool pauseTerminal          = true;
 static bool dirRecurse             = false;
-static bool renderTerrain          = false;
-static bool renderPathing          = false;
-static bool renderBases            = false;
-static bool renderOpenness         = false;
-static bool renderShortest         = false;
-static bool renderInfluence        = false;
-static bool renderInfluenceHeatMap = false;
-static bool renderSummary          = false;
-static bool writeCSVpermap         = false;
 static bool writeCSVaggr           = false;
 
+// how many workers each stage of the pipeline has,
+// set on the command line with --read-jobs N, --jobs N
+// (the analysis, which is most of the work) and
+// --render-jobs N
+static int readJobs    = 1;
+static int analyzeJobs = 1;
+static int renderJobs  = 1;
+
+// how many maps may wait between two stages, each
+// one holds a whole map's analysis in memory
+static const int MAP_QUEUE_CAPACITY = 2;
+
+// every file found on the to-analyze lists, in
+// the order found, waiting for a read worker
+static vector<string>  filesToTry;
+static int             nextFileToTry = 0;
+static pthread_mutex_t filesLock     = PTHREAD_MUTEX_INITIALIZER;
+
+// the queues between the stages, read workers push
+// to the first and output workers pop from the second
+static MapQueue* toAnalyze = NULL;
+static MapQueue* toOutput  = NULL;
+
 
 void statFail( string* fileFullPath );
 
 void tryFileOrDir( string* fileFullPath, bool first, bool recurse );
-void tryFile     ( string* fileFullPath );
+
+SC2Map* loadMap   ( string* fileFullPath );
+void    analyzeMap( SC2Map* sc2map );
+void    outputMap ( SC2Map* sc2map, int order );
+
+void pipelineJob( void*, int job, int );
 
 
 void AtExit()
 {
+  // finish writing any images still queued
+  flushPngQueue();
+
   // flush output
   fflush( stdout );
   fflush( stderr );
@@ -65,9 +92,39 @@ int main( int argc, char** argv )
   atexit( &AtExit );
 
 
-  if( SC2Map::pngwriterTest() != 0 )
+  for( int i = 1; i < argc; ++i )
   {
-    printError( "Cannot load resources for PNGwriter: you may need to run this program as Administrator.\n" );
+    int* jobs = NULL;
+
+    if( strcmp( argv[i], "--jobs" ) == 0 )
+    {
+      jobs = &analyzeJobs;
+    } else if( strcmp( argv[i], "--read-jobs" ) == 0 ) {
+      jobs = &readJobs;
+    } else if( strcmp( argv[i], "--render-jobs" ) == 0 ) {
+      jobs = &renderJobs;
+    }
+
+    if( jobs == NULL || i + 1 >= argc )
+    {
+      printWarning( "Unknown argument %s, ignoring it.\n", argv[i] );
+      continue;
+    }
+
+    ++i;
+    *jobs = atoi( argv[i] );
+
+    if( *jobs < 1 )
+    {
+      printWarning( "%s needs a number of 1 or more, using 1.\n", argv[i - 1] );
+      *jobs = 1;
+    }
+  }
+
+
+  if( SC2Map::fontTest() != 0 )
+  {
+    printError( "Cannot load the font for rendering images: you may need to run this program as Administrator.\n" );
     exit( -1 );
   }
 
@@ -116,6 +173,26 @@ int main( int argc, char** argv )
   }
 
 
+  // maps flow through three stages, reading, analysis and
+  // output, with their own workers and a bounded queue
+  // between each, so while one map is analyzed the next
+  // is loading and the one before is being rendered.
+  // Every stage worker is one long job of the pool.
+  if( !filesToTry.empty() )
+  {
+    toAnalyze = new MapQueue( MAP_QUEUE_CAPACITY, readJobs    );
+    toOutput  = new MapQueue( MAP_QUEUE_CAPACITY, analyzeJobs );
+
+    int numStageJobs = readJobs + analyzeJobs + renderJobs;
+
+    WorkerPool pipeline( numStageJobs );
+    pipeline.run( numStageJobs, &pipelineJob, NULL );
+
+    delete toOutput;
+    delete toAnalyze;
+  }
+
+
   if( writeCSVaggr )
   {
     printMessage( "Calculating aggregate statistics...\n" );
@@ -199,7 +276,7 @@ void tryFileOrDir( string* fileFullPathIn, bool first, bool recurse )
   // ignore other file types (or "modes")
   if( S_ISREG( fileStatus.st_mode ) )
   {
-    tryFile( &fileFullPath );
+    filesToTry.push_back( fileFullPath );
 
 
   } else if( S_ISDIR( fileStatus.st_mode ) ) {
@@ -244,9 +321,77 @@ void tryFileOrDir( string* fileFullPathIn, bool first, bool recurse )
 
 
 
+// each read worker takes the next file off the list
+// until there are none left
+void readStage()
+{
+  while( true )
+  {
+    pthread_mutex_lock( &filesLock );
+    int order = nextFileToTry;
+    if( nextFileToTry < (int)filesToTry.size() )
+    {
+      ++nextFileToTry;
+    }
+    pthread_mutex_unlock( &filesLock );
+
+    if( order >= (int)filesToTry.size() )
+    {
+      break;
+    }
+
+    SC2Map* sc2map = loadMap( &(filesToTry[order]) );
+    if( sc2map != NULL )
+    {
+      toAnalyze->push( sc2map, order );
+    }
+  }
+
+  toAnalyze->producerDone();
+}
+
+
+void analyzeStage()
+{
+  QueuedMap qm;
+  while( toAnalyze->pop( &qm ) )
+  {
+    analyzeMap( qm.sc2map );
+    toOutput->push( qm.sc2map, qm.order );
+  }
+
+  toOutput->producerDone();
+}
+
+
+void outputStage()
+{
+  QueuedMap qm;
+  while( toOutput->pop( &qm ) )
+  {
+    outputMap( qm.sc2map, qm.order );
+  }
+}
+
+
+void pipelineJob( void*, int job, int )
+{
+  if( job < readJobs )
+  {
+    readStage();
+  } else if( job < readJobs + analyzeJobs ) {
+    analyzeStage();
+  } else {
+    outputStage();
+  }
+}
+
+
+
 // found a regular file, see if it has a map
-// extension and then try to open the archive
-void tryFile( string* fileFullPath )
+// extension and then try to open the archive,
+// NULL means there is nothing to analyze
+SC2Map* loadMap( string* fileFullPath )
 {
   string ext1( ".s2ma" );
   string ext2( ".SC2Map" );
@@ -260,7 +405,7 @@ void tryFile( string* fileFullPath )
       loc2 != fileFullPath->size() - ext2.size() )
   {
     // not a Starcraft 2 Map Archive...
-    return;
+    return NULL;
   }
 
   // find last dot, last back slash
@@ -315,25 +460,23 @@ void tryFile( string* fileFullPath )
     }
   }
 
-  renderTerrain          = sc2map->getOutputOption( "renderTerrain"          );
-  renderPathing          = sc2map->getOutputOption( "renderPathing"          );
-  renderBases            = sc2map->getOutputOption( "renderBases"            );
-  renderOpenness         = sc2map->getOutputOption( "renderOpenness"         );
-  renderShortest         = sc2map->getOutputOption( "renderShortest"         );
-  renderInfluence        = sc2map->getOutputOption( "renderInfluence"        );
-  renderInfluenceHeatMap = sc2map->getOutputOption( "renderInfluenceHeatMap" );
-  renderSummary          = sc2map->getOutputOption( "renderSummary"          );
-  writeCSVpermap         = sc2map->getOutputOption( "writeCSVpermap"         );
-
   if( sc2map->readMap() < 0 )
   {
     printWarning( "Could not read required map files for %s, skipping\n\n", file.data() );
-    return;
+    return NULL;
   }
 
-  printMessage( "Prepping analysis,\n" );
+  return sc2map;
+}
+
+
+
+void analyzeMap( SC2Map* sc2map )
+{
+  printMessage( "Prepping analysis of %s,\n", sc2map->mapName.data() );
 
   sc2map->countPathableCells();
+  sc2map->labelComponents();
 
   printMessage( "." );
 
@@ -341,6 +484,10 @@ void tryFile( string* fileFullPath )
 
   printMessage( "." );
 
+  sc2map->detectSymmetry();
+
+  printMessage( "." );
+
   sc2map->identifyBases();
 
   printMessage( "." );
@@ -355,34 +502,39 @@ void tryFile( string* fileFullPath )
 
   sc2map->analyzeBases();
 
-  printMessage( "\nAnalyzing and generating output,\n" );
-  printMessage( "  Map-specific output in [%s]\n", sc2map->outputPath.data() );
+  printMessage( "." );
 
-  if( renderTerrain )
-  {
-    sc2map->renderImageTerrainOnly();
-  }
+  sc2map->analyzeVision();
 
   printMessage( "." );
 
-  if( renderPathing )
-  {
-    sc2map->renderImagesPathing();
-  }
+  sc2map->computeTerritories();
 
-  printMessage( "." );
+  printMessage( "\n" );
+}
 
-  if( renderBases )
-  {
-    sc2map->renderImageBases();
-  }
 
-  printMessage( "." );
 
-  if( renderOpenness )
-  {
-    sc2map->renderImageOpenness();
-  }
+void outputMap( SC2Map* sc2map, int order )
+{
+  bool renderTerrain          = sc2map->getOutputOption( "renderTerrain"          );
+  bool renderPathing          = sc2map->getOutputOption( "renderPathing"          );
+  bool renderBases            = sc2map->getOutputOption( "renderBases"            );
+  bool renderOpenness         = sc2map->getOutputOption( "renderOpenness"         );
+  bool renderShortest         = sc2map->getOutputOption( "renderShortest"         );
+  bool renderInfluence        = sc2map->getOutputOption( "renderInfluence"        );
+  bool renderInfluenceHeatMap = sc2map->getOutputOption( "renderInfluenceHeatMap" );
+  bool renderSummary          = sc2map->getOutputOption( "renderSummary"          );
+  bool writeCSVpermap         = sc2map->getOutputOption( "writeCSVpermap"         );
+
+  printMessage( "\nAnalyzing and generating output for %s,\n", sc2map->mapName.data() );
+  printMessage( "  Map-specific output in [%s]\n", sc2map->outputPath.data() );
+
+  sc2map->renderCellImages( renderTerrain,
+                            renderPathing,
+                            renderBases,
+                            renderOpenness,
+                            renderSummary );
 
   printMessage( "." );
 
@@ -407,13 +559,6 @@ void tryFile( string* fileFullPath )
 
   printMessage( "." );
 
-  if( renderSummary )
-  {
-    sc2map->renderImageSummary();
-  }
-
-  printMessage( "." );
-
   if( writeCSVpermap )
   {
     sc2map->writeToCSV();
@@ -423,7 +568,7 @@ void tryFile( string* fileFullPath )
 
   if( writeCSVaggr )
   {
-    mapAggregator.aggregate( sc2map );
+    mapAggregator.aggregate( sc2map, order );
   }
 
   printMessage( "\n\n" );
@@ -49,6 +49,10 @@ void SC2Map::writeToCSV()
     fprintf( fileCSV, "Ground distance to %s Third2Third WITH ROCKS,",           sl->name );
   }
 
+  fprintf( fileCSV, "Symmetric Partner," );
+  fprintf( fileCSV, "Ground Territory %%," );
+  fprintf( fileCSV, "Cliff-walk Territory %%," );
+
   //fprintf( fileCSV, "Worst Positional Balance %%" );
   fprintf( fileCSV, "\n" );
 
@@ -115,23 +119,33 @@ void SC2Map::writeToCSV()
       //fprintf( fileCSV, "%.1f,", GroundDecreaseRemRocks );
       //fprintf( fileCSV, "%.1f,", CWalkDecreaseRemRocks  );
       fprintf( fileCSV, "%.1f,", dNat2Nat               );
-      //fprintf( fileCSV, "%.1f,", sl1->sl2percentBalancedByResources[sl2] );
-      //fprintf( fileCSV, "%.1f,", sl1->sl2percentBalancedByOpenness[sl2] );
+      //fprintf( fileCSV, "%.1f,", sl2percentBalancedByResources[slPair( sl1, sl2 )] );
+      //fprintf( fileCSV, "%.1f,", sl2percentBalancedByOpenness[slPair( sl1, sl2 )] );
       fprintf( fileCSV, "%.1f,", dThird2Third               );
 
       /*
-      if( sl1->sl2percentBalancedByResources[sl2] < worstPBalance )
+      if( sl2percentBalancedByResources[slPair( sl1, sl2 )] < worstPBalance )
       {
-        worstPBalance = sl1->sl2percentBalancedByResources[sl2];
+        worstPBalance = sl2percentBalancedByResources[slPair( sl1, sl2 )];
       }
 
-      if( sl1->sl2percentBalancedByOpenness[sl2] < worstPBalance )
+      if( sl2percentBalancedByOpenness[slPair( sl1, sl2 )] < worstPBalance )
       {
-        worstPBalance = sl1->sl2percentBalancedByOpenness[sl2];
+        worstPBalance = sl2percentBalancedByOpenness[slPair( sl1, sl2 )];
       }
       */
     }
 
+    if( sl1->symmetricPartner != NULL )
+    {
+      fprintf( fileCSV, "%s,", sl1->symmetricPartner->name );
+    } else {
+      fprintf( fileCSV, "-," );
+    }
+
+    fprintf( fileCSV, "%.1f,", 100.0f * territoryShare[PATH_GROUND_WITHROCKS][sl1->index] );
+    fprintf( fileCSV, "%.1f,", 100.0f * territoryShare[PATH_CWALK_WITHROCKS ][sl1->index] );
+
     //fprintf( fileCSV, "%f", worstPBalance );
     fprintf( fileCSV, "\n" );
   }
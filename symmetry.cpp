@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <math.h>
+
+#include "outstreams.hpp"
+#include "utility.hpp"
+#include "coordinates.hpp"
+#include "BitPlane.hpp"
+#include "SC2Map.hpp"
+
+
+
+////////////////////////////////////////////
+//
+//  Competitive maps are nearly always
+//  rotated or mirrored copies of one half
+//  (or quarter), so the map is checked
+//  against each symmetry by comparing the
+//  pathing and height of every cell with
+//  the cell it maps onto.  A few stray
+//  doodads shouldn't spoil it, so a small
+//  fraction of cells may disagree.
+//
+//  When the pathing of a path type matches
+//  exactly, the path graph maps onto itself
+//  (the 16 neighbor links look the same
+//  from any rotation or mirror) so the
+//  shortest paths from a node are the ones
+//  from its image, transformed.  Then only
+//  one start location of each symmetric
+//  set needs a search, the rest are copied.
+//
+////////////////////////////////////////////
+
+// a start location maps onto a partner if one
+// is within this many cells of its image
+static const float symmetricPartnerRadius = 3.0f;
+
+
+void SC2Map::detectSymmetry()
+{
+  symmetry = SYMMETRY_NONE;
+
+  float bestMismatch = rc.symmetryTolerance;
+
+  // candidates are checked strongest first and a weaker
+  // one only wins if it matches strictly better
+  for( int s = SYMMETRY_ROT4; s < NUM_SYMMETRY_TYPES; ++s )
+  {
+    if( symmetryOrder( (SymmetryType)s ) == 0 )
+    {
+      continue;
+    }
+
+    bool  exact[NUM_PATH_TYPES];
+    float mismatch = symmetryMismatch( (SymmetryType)s, exact );
+
+    if( symmetry == SYMMETRY_NONE ? mismatch <= bestMismatch
+                                  : mismatch <  bestMismatch )
+    {
+      symmetry     = (SymmetryType)s;
+      bestMismatch = mismatch;
+
+      for( int t = 0; t < NUM_PATH_TYPES; ++t )
+      {
+        symmetricGraph[t] = exact[t];
+      }
+    }
+  }
+
+  if( symmetry == SYMMETRY_NONE )
+  {
+    return;
+  }
+
+  // a map is only symmetric for the players if every
+  // start location lands on another one
+  for( list<StartLoc*>::const_iterator itr1 = startLocs.begin();
+       itr1 != startLocs.end();
+       ++itr1 )
+  {
+    StartLoc* sl1 = *itr1;
+
+    point image;
+    int pci, pcj;
+    symmetricCell( symmetry, 1, sl1->loc.pcx, sl1->loc.pcy, &pci, &pcj );
+    image.pcSet( &frame, pci, pcj );
+
+    for( list<StartLoc*>::const_iterator itr2 = startLocs.begin();
+         itr2 != startLocs.end();
+         ++itr2 )
+    {
+      StartLoc* sl2 = *itr2;
+
+      if( p2pDistance( &image, &(sl2->loc) ) < symmetricPartnerRadius )
+      {
+        sl1->symmetricPartner = sl2;
+        break;
+      }
+    }
+
+    if( sl1->symmetricPartner == NULL )
+    {
+      printWarning( "Map terrain looks like a %s but start locations don't match.\n",
+                    getSymmetryName() );
+
+      symmetry = SYMMETRY_NONE;
+      break;
+    }
+  }
+
+  if( symmetry == SYMMETRY_NONE )
+  {
+    for( list<StartLoc*>::const_iterator itr = startLocs.begin();
+         itr != startLocs.end();
+         ++itr )
+    {
+      (*itr)->symmetricPartner = NULL;
+    }
+
+    for( int t = 0; t < NUM_PATH_TYPES; ++t )
+    {
+      symmetricGraph[t] = false;
+    }
+  }
+}
+
+
+const char* SC2Map::getSymmetryName()
+{
+  const char* name = "none";
+
+  switch( symmetry )
+  {
+    case SYMMETRY_ROT4:            { name = "4-fold rotation";      } break;
+    case SYMMETRY_ROT2:            { name = "2-fold rotation";      } break;
+    case SYMMETRY_MIRROR_X:        { name = "left-right mirror";    } break;
+    case SYMMETRY_MIRROR_Y:        { name = "top-bottom mirror";    } break;
+    case SYMMETRY_MIRROR_DIAG:     { name = "diagonal mirror";      } break;
+    case SYMMETRY_MIRROR_ANTIDIAG: { name = "anti-diagonal mirror"; } break;
+    default: break;
+  }
+
+  return name;
+}
+
+
+int SC2Map::symmetryOrder( SymmetryType s )
+{
+  // the quarter turn and the diagonals need a square
+  // map, otherwise the map can't have them at all
+  bool square = cxDimPlayable == cyDimPlayable;
+
+  int order = 1;
+
+  switch( s )
+  {
+    case SYMMETRY_ROT4:
+    {
+      order = square ? 4 : 0;
+    } break;
+
+    case SYMMETRY_ROT2:
+    case SYMMETRY_MIRROR_X:
+    case SYMMETRY_MIRROR_Y:
+    {
+      order = 2;
+    } break;
+
+    case SYMMETRY_MIRROR_DIAG:
+    case SYMMETRY_MIRROR_ANTIDIAG:
+    {
+      order = square ? 2 : 0;
+    } break;
+
+    default: break;
+  }
+
+  return order;
+}
+
+
+void SC2Map::symmetricCell( SymmetryType s, int k,
+                            int pci, int pcj,
+                            int* pciOut, int* pcjOut )
+{
+  int xMax = cxDimPlayable - 1;
+  int yMax = cyDimPlayable - 1;
+
+  for( int i = 0; i < k; ++i )
+  {
+    int x = pci;
+    int y = pcj;
+
+    switch( s )
+    {
+      case SYMMETRY_ROT4:            { pci = xMax - y; pcj = x;        } break;
+      case SYMMETRY_ROT2:            { pci = xMax - x; pcj = yMax - y; } break;
+      case SYMMETRY_MIRROR_X:        { pci = xMax - x; pcj = y;        } break;
+      case SYMMETRY_MIRROR_Y:        { pci = x;        pcj = yMax - y; } break;
+      case SYMMETRY_MIRROR_DIAG:     { pci = y;        pcj = x;        } break;
+      case SYMMETRY_MIRROR_ANTIDIAG: { pci = xMax - y; pcj = yMax - x; } break;
+      default: break;
+    }
+  }
+
+  *pciOut = pci;
+  *pcjOut = pcj;
+}
+
+
+float SC2Map::symmetryMismatch( SymmetryType s, bool* exact )
+{
+  int numMismatched = 0;
+  int numMismatchedPathing[NUM_PATH_TYPES];
+
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    numMismatchedPathing[t] = 0;
+  }
+
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+  {
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
+    {
+      int pciImage, pcjImage;
+      symmetricCell( s, 1, pci, pcj, &pciImage, &pcjImage );
+
+      for( int t = 0; t < NUM_PATH_TYPES; ++t )
+      {
+        if( mapPathing[t].get( pci,      pcj      ) !=
+            mapPathing[t].get( pciImage, pcjImage ) )
+        {
+          ++numMismatchedPathing[t];
+        }
+      }
+
+      if( mapPathing[PATH_GROUND_NOROCKS].get( pci,      pcj      ) !=
+          mapPathing[PATH_GROUND_NOROCKS].get( pciImage, pcjImage ) ||
+          getHeightCell( cell( pci,      pcj      ) ) !=
+          getHeightCell( cell( pciImage, pcjImage ) ) )
+      {
+        ++numMismatched;
+      }
+    }
+  }
+
+  for( int t = 0; t < NUM_PATH_TYPES; ++t )
+  {
+    exact[t] = numMismatchedPathing[t] == 0;
+  }
+
+  return (float)numMismatched / ((float)cxDimPlayable * (float)cyDimPlayable);
+}
+
+
+bool SC2Map::deriveShortestPaths( Node* src, PathType t )
+{
+  if( symmetry == SYMMETRY_NONE || !symmetricGraph[t] )
+  {
+    return false;
+  }
+
+  int order = symmetryOrder( symmetry );
+
+  for( int k = 1; k < order; ++k )
+  {
+    int pci, pcj;
+    symmetricCell( symmetry, k, src->loc.pcx, src->loc.pcy, &pci, &pcj );
+
+    Node* image = mapPathNodes[t].at( pci, pcj );
+
+    if( image == NULL || !(image->pathsFromThisSrcCalculated) )
+    {
+      continue;
+    }
+
+    // the distance from src to v is the distance from the
+    // image of src to the image of v, and the predecessor
+    // is the image's predecessor mapped back again
+    float*  dImage =  d[t][image->id];
+    Node** piImage = pi[t][image->id];
+
+    float*  dEntry = arena.makeArray<float>( nodes[t].size() );
+    Node** piEntry = arena.makeArray<Node*>( nodes[t].size() );
+
+    for( int i = 0; i < (int)nodes[t].size(); ++i )
+    {
+      Node* v = nodes[t][i];
+
+      symmetricCell( symmetry, k, v->loc.pcx, v->loc.pcy, &pci, &pcj );
+      Node* vImage = mapPathNodes[t].at( pci, pcj );
+
+      assert( vImage != NULL );
+
+      dEntry[v->id] = dImage[vImage->id];
+
+      Node* p = piImage[vImage->id];
+      if( p != NULL )
+      {
+        symmetricCell( symmetry, order - k, p->loc.pcx, p->loc.pcy, &pci, &pcj );
+        p = mapPathNodes[t].at( pci, pcj );
+      }
+      piEntry[v->id] = p;
+    }
+
+    d [t].insert( make_pair( src->id,  dEntry ) );
+    pi[t].insert( make_pair( src->id, piEntry ) );
+
+    return true;
+  }
+
+  return false;
+}
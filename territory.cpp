@@ -0,0 +1,181 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+
+#include <queue>
+#include <vector>
+using namespace std;
+
+#include "outstreams.hpp"
+#include "coordinates.hpp"
+#include "BitPlane.hpp"
+#include "SC2Map.hpp"
+
+
+
+////////////////////////////////////////////
+//
+//  Territory is one shortest path search
+//  seeded from every start location at
+//  once.  Each queue entry carries the
+//  start location it came from, and a node
+//  takes the first two different start
+//  locations that reach it: the first is
+//  its nearest, the second its runner-up.
+//  A node settled twice is done, so the
+//  whole partition costs about two plain
+//  searches no matter how many players,
+//  instead of a search for every pair.
+//
+//  The gap between the two distances says
+//  how contested a cell is, a cell where
+//  both are about as far is up for grabs.
+//
+////////////////////////////////////////////
+
+// a start location's tentative distance to a node,
+// the queue can hold several of these for one node
+// and the ones that lost are skipped on the way out
+struct TerritoryLabel
+{
+  float d;
+  int   nodeId;
+  int   slIndex;
+
+  bool operator>( const TerritoryLabel& other ) const
+  {
+    return d > other.d;
+  }
+};
+
+typedef priority_queue< TerritoryLabel,
+                        vector<TerritoryLabel>,
+                        greater<TerritoryLabel> > TerritoryQueue;
+
+
+void SC2Map::computeTerritories()
+{
+  computeTerritory( PATH_GROUND_WITHROCKS );
+  computeTerritory( PATH_CWALK_WITHROCKS  );
+}
+
+
+void SC2Map::computeTerritory( PathType t )
+{
+  Territory unclaimed;
+  unclaimed.nearest  = -1;
+  unclaimed.second   = -1;
+  unclaimed.dNearest = infinity;
+  unclaimed.margin   = infinity;
+
+  Grid<Territory>* territory = &(mapTerritory[t]);
+  territory->resize( cxDimPlayable, cyDimPlayable, 0, unclaimed );
+
+  // how many start locations have claimed each node
+  vector<u8> claims( nodes[t].size(), 0 );
+
+  TerritoryQueue queue;
+
+  for( list<StartLoc*>::const_iterator itr = startLocs.begin();
+       itr != startLocs.end();
+       ++itr )
+  {
+    StartLoc* sl = *itr;
+
+    Node* src = getPathNode( &(sl->loc), t );
+    if( src == NULL )
+    {
+      continue;
+    }
+
+    TerritoryLabel label = { 0.0f, src->id, sl->index };
+    queue.push( label );
+  }
+
+  while( !queue.empty() )
+  {
+    TerritoryLabel label = queue.top();
+    queue.pop();
+
+    Node*      u  = nodes[t][label.nodeId];
+    Territory* tu = &(territory->at( u->loc.pcx, u->loc.pcy ));
+
+    if( claims[u->id] == 2 ||
+        (claims[u->id] == 1 && tu->nearest == label.slIndex) )
+    {
+      continue;
+    }
+
+    if( claims[u->id] == 0 )
+    {
+      tu->nearest  = label.slIndex;
+      tu->dNearest = label.d;
+    } else {
+      tu->second = label.slIndex;
+      tu->margin = label.d - tu->dNearest;
+    }
+    ++claims[u->id];
+
+    for( int i = 0; i < NUM_NODE_NEIGHBORS; ++i )
+    {
+      Node* v = u->neighbors[i];
+
+      if( v == NULL ) { continue; }
+
+      // don't queue what the node would turn away anyway
+      if( claims[v->id] == 2 ||
+          (claims[v->id] == 1 &&
+           territory->at( v->loc.pcx, v->loc.pcy ).nearest == label.slIndex) )
+      {
+        continue;
+      }
+
+      TerritoryLabel next = { label.d + neighborWeights[i], v->id, label.slIndex };
+      queue.push( next );
+    }
+  }
+
+
+  // tally the shares and the contested cells
+  contestedTerritory[t].resize( cxDimPlayable, cyDimPlayable );
+
+  territoryShare[t].assign( numStartLocs, 0.0f );
+
+  int numReached   = 0;
+  int numContested = 0;
+
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+  {
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
+    {
+      Territory* tc = &(territory->at( pci, pcj ));
+
+      if( tc->nearest < 0 )
+      {
+        continue;
+      }
+
+      ++numReached;
+      territoryShare[t][tc->nearest] += 1.0f;
+
+      if( tc->margin < rc.territoryContestedMargin )
+      {
+        ++numContested;
+        contestedTerritory[t].set( pci, pcj );
+      }
+    }
+  }
+
+  if( numReached == 0 )
+  {
+    territoryContested[t] = 0.0f;
+    return;
+  }
+
+  for( int i = 0; i < numStartLocs; ++i )
+  {
+    territoryShare[t][i] /= (float)numReached;
+  }
+
+  territoryContested[t] = (float)numContested / (float)numReached;
+}
@@ -0,0 +1,253 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <math.h>
+
+#include "outstreams.hpp"
+#include "coordinates.hpp"
+#include "BitPlane.hpp"
+#include "SC2Map.hpp"
+
+
+
+////////////////////////////////////////////
+//
+//  Vision is computed with recursive
+//  shadowcasting: each of the 8 octants
+//  around a viewer is scanned row by row
+//  moving away from the viewer, and when
+//  a row hits an opaque cell the scan
+//  splits, narrowing the slopes of light
+//  that continue on past the blocker.
+//
+//  A cell is opaque to a viewer when it is
+//  on higher ground than the viewer or when
+//  a line-of-sight blocker sits on it.
+//  Higher ground is never visible from
+//  below, blockers themselves are visible.
+//
+////////////////////////////////////////////
+
+// multipliers that transform the one octant the
+// scan understands into each of the 8 octants
+static int octantXX[] = { 1,  0,  0, -1, -1,  0,  0,  1 };
+static int octantXY[] = { 0,  1, -1,  0,  0, -1,  1,  0 };
+static int octantYX[] = { 0,  1,  1,  0,  0, -1, -1,  0 };
+static int octantYY[] = { 1,  0,  0,  1, -1,  0,  0, -1 };
+
+
+void SC2Map::analyzeVision()
+{
+  prepVision();
+
+  // the union of what every watchtower sees
+  // when line of sight is respected
+  watchtowerVision.resize( cxDimPlayable, cyDimPlayable );
+
+  for( list<Watchtower*>::const_iterator wtItr = watchtowers.begin();
+       wtItr != watchtowers.end();
+       ++wtItr )
+  {
+    Watchtower* wt = *wtItr;
+    computeVision( &(wt->loc), wt->range, &(watchtowerVision) );
+  }
+
+  watchtowerVisionCoverage =
+    (float)watchtowerVision.countAnd( &(mapPathing[PATH_GROUND_NOROCKS]) ) /
+    (float)numPathableCells[PATH_GROUND_NOROCKS];
+
+  mainPathVision = calculatePathVision( &(watchtowerVision), PATH_GROUND_WITHROCKS );
+}
+
+
+void SC2Map::prepVision()
+{
+  visionHeight.resize( cxDimPlayable, cyDimPlayable, 0, 0 );
+
+  visionBlockers.resize( cxDimPlayable, cyDimPlayable );
+
+  for( int pcj = 0; pcj < cyDimPlayable; ++pcj )
+  {
+    for( int pci = 0; pci < cxDimPlayable; ++pci )
+    {
+      visionHeight.at( pci, pcj ) = getHeightCell( cell( pci, pcj ) );
+    }
+  }
+
+  for( list<LoSB*>::const_iterator itr = losbs.begin();
+       itr != losbs.end();
+       ++itr )
+  {
+    LoSB* losb = *itr;
+
+    if( isPlayableCell( &(losb->loc) ) )
+    {
+      visionBlockers.set( losb->loc.pcx, losb->loc.pcy );
+    }
+  }
+}
+
+
+// set the bits of every cell visible from the point p within
+// the given range, cells already set in the plane stay set so
+// vision from several sources can be accumulated in one plane
+void SC2Map::computeVision( point* p, float range, BitPlane* visible )
+{
+  if( !isPlayableCell( p ) )
+  {
+    printWarning( "Cannot compute vision from unplayable cell (%d, %d).\n",
+                  p->pcx,
+                  p->pcy );
+    return;
+  }
+
+  u8 viewerHeight = visionHeight.at( p->pcx, p->pcy );
+
+  visible->set( p->pcx, p->pcy );
+
+  for( int oct = 0; oct < 8; ++oct )
+  {
+    castLight( p->pcx, p->pcy, viewerHeight, range,
+               1, 1.0f, 0.0f,
+               octantXX[oct], octantXY[oct],
+               octantYX[oct], octantYY[oct],
+               visible );
+  }
+}
+
+
+void SC2Map::castLight( int cx, int cy, u8 viewerHeight, float range,
+                        int row, float slopeStart, float slopeEnd,
+                        int xx, int xy, int yx, int yy,
+                        BitPlane* visible )
+{
+  if( slopeStart < slopeEnd )
+  {
+    return;
+  }
+
+  float rangeSq  = range*range;
+  int   rowLimit = (int)range;
+
+  float slopeNextStart = 0.0f;
+
+  for( int j = row; j <= rowLimit; ++j )
+  {
+    bool blocked = false;
+    int  dy      = -j;
+
+    for( int dx = -j; dx <= 0; ++dx )
+    {
+      int x = cx + dx*xx + dy*xy;
+      int y = cy + dx*yx + dy*yy;
+
+      float slopeLeft  = ((float)dx - 0.5f) / ((float)dy + 0.5f);
+      float slopeRight = ((float)dx + 0.5f) / ((float)dy - 0.5f);
+
+      if( slopeStart < slopeRight )
+      {
+        continue;
+      }
+      if( slopeEnd > slopeLeft )
+      {
+        break;
+      }
+
+      bool opaque;
+      if( !visible->inBounds( x, y ) )
+      {
+        // the edge of the playable area blocks everything
+        opaque = true;
+
+      } else {
+        bool higher = visionHeight.at( x, y ) > viewerHeight;
+
+        opaque = higher || visionBlockers.get( x, y );
+
+        if( !higher && (float)(dx*dx + dy*dy) <= rangeSq )
+        {
+          visible->set( x, y );
+        }
+      }
+
+      if( blocked )
+      {
+        if( opaque )
+        {
+          slopeNextStart = slopeRight;
+          continue;
+        }
+
+        blocked    = false;
+        slopeStart = slopeNextStart;
+
+      } else if( opaque && j < rowLimit ) {
+        // light continues past this blocker in a narrower
+        // wedge, scan that wedge on its own from the next row
+        blocked = true;
+        castLight( cx, cy, viewerHeight, range,
+                   j + 1, slopeStart, slopeLeft,
+                   xx, xy, yx, yy,
+                   visible );
+        slopeNextStart = slopeRight;
+      }
+    }
+
+    if( blocked )
+    {
+      break;
+    }
+  }
+}
+
+
+// walk the shortest path between every pair of mains and
+// return the fraction of cells along those paths that are
+// set in the vision plane
+float SC2Map::calculatePathVision( BitPlane* visible, PathType t )
+{
+  int cellsOnPaths = 0;
+  int cellsSeen    = 0;
+
+  for( list<StartLoc*>::const_iterator itr1 = startLocs.begin();
+       itr1 != startLocs.end();
+       ++itr1 )
+  {
+    StartLoc* sl1 = *itr1;
+
+    list<StartLoc*>::const_iterator itr2 = itr1;
+    ++itr2;
+    for( ; itr2 != startLocs.end(); ++itr2 )
+    {
+      StartLoc* sl2 = *itr2;
+
+      Node* src = getPathNode( &(sl1->loc), t );
+      Node* v   = getPathNode( &(sl2->loc), t );
+
+      if( src == NULL || v == NULL ||
+          !sameComponent( &(src->loc), &(v->loc), t ) )
+      {
+        // no path, just skip this pairing
+        continue;
+      }
+
+      while( v != NULL )
+      {
+        ++cellsOnPaths;
+        if( visible->get( v->loc.pcx, v->loc.pcy ) )
+        {
+          ++cellsSeen;
+        }
+
+        v = getShortestPathPredecessor( src, v, t );
+      }
+    }
+  }
+
+  if( cellsOnPaths == 0 )
+  {
+    return 0.0f;
+  }
+
+  return (float)cellsSeen / (float)cellsOnPaths;
+}